@@ -28,6 +28,7 @@
 
 #include <chrono>
 #include <memory>
+#include <string>
 
 #include "yy_cpp/yy_observer_ptr.hpp"
 #include "yy_cpp/yy_vector.h"
@@ -43,19 +44,13 @@ class Store;
 } // namespace yafiyogi::values
 
 namespace yafiyogi::actions {
-namespace actions_detail {
-
-inline int compare_param(const yy_values::MetricDataObsPtr param,
-                         const yy_values::MetricId & target)
-{
-  return param->Id().compare(target);
-}
-
-}
 
 class Store;
 
+// The params of an action, one per distinct input. Inputs not in the
+// current batch are empty.
 using ParamVector = yy_quad::simple_vector<yy_values::MetricDataObsPtr>;
+using ParamIds = yy_quad::simple_vector<std::string>;
 
 class Action
 {
@@ -68,10 +63,45 @@ class Action
     constexpr Action & operator=(const Action &) noexcept = default;
     constexpr Action & operator=(Action &&) noexcept = default;
 
+    // The value id of each param, in param order. Called once when the
+    // actions store is created.
+    virtual void BindParams(const ParamIds & /* p_param_ids */) noexcept
+    {
+    }
+
+    // The param is the output of another action. It has no metric data,
+    // the action is triggered with an empty param after the other action
+    // has written the output to the values store.
+    virtual void BindChained(size_type /* p_param */) noexcept
+    {
+    }
+
+    // Resolve value ids to store slots, once before the first Run().
+    virtual void Resolve(values::Store & /* p_values_store */) noexcept
+    {
+    }
+
     virtual void Run(const ParamVector & p_params,
                      ActionResultVector & p_results,
                      values::Store & p_values_store,
                      timestamp_type p_timestamp) noexcept = 0;
+
+    // Completes a Run() that handed its work to an Engine, after the
+    // engine has run.
+    virtual void Finish(ActionResultVector & /* p_results */,
+                        values::Store & /* p_values_store */,
+                        timestamp_type /* p_timestamp */) noexcept
+    {
+    }
+
+    // False if Run() shares state with other actions (e.g. an Engine),
+    // so it must not run on a worker thread.
+    [[nodiscard]]
+    virtual bool Concurrent() const noexcept
+    {
+      return true;
+    }
+
     virtual const std::string_view Id() const noexcept = 0;
     virtual const std::string_view Name() const noexcept = 0;
 };
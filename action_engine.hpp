@@ -0,0 +1,64 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <memory>
+
+#include "yy_cpp/yy_types.hpp"
+
+#include "action_result.hpp"
+
+namespace yafiyogi::values {
+
+class Store;
+
+} // namespace yafiyogi::values
+
+namespace yafiyogi::actions {
+
+// Shared work handed over by actions during a batch. The engines are run
+// after all the actions of a batch, then complete the actions with
+// Action::Finish().
+class Engine
+{
+  public:
+    constexpr Engine() noexcept = default;
+    Engine(const Engine &) = delete;
+    Engine(Engine &&) = delete;
+    virtual ~Engine() noexcept = default;
+
+    Engine & operator=(const Engine &) = delete;
+    Engine & operator=(Engine &&) = delete;
+
+    virtual void Run(ActionResultVector & p_results,
+                     values::Store & p_values_store,
+                     timestamp_type p_timestamp) noexcept = 0;
+};
+
+using EnginePtr = std::unique_ptr<Engine>;
+
+} // namespace yafiyogi::actions
@@ -24,10 +24,14 @@
 
 */
 
+#include <algorithm>
+#include <array>
 #include <charconv>
+#include <optional>
 
 #include "fmt/compile.h"
 #include "fmt/format.h"
+#include "fmt/ranges.h"
 #include "spdlog/spdlog.h"
 
 #include "yy_cpp/yy_find_iter_util.hpp"
@@ -58,14 +62,81 @@ constexpr auto g_ouput_value_id{"{}:{}"_cf};
 
 constexpr auto g_predict_interval{timestamp_type{std::chrono::seconds(60)}};
 
+yy_values::MetricDataObsPtr find_param(const ParamVector & p_params,
+                                       const kalman_action_detail::InputMapping & p_input) noexcept
+{
+  if(p_input.param_idx < p_params.size())
+  {
+    return p_params[p_input.param_idx];
+  }
+
+  return yy_values::MetricDataObsPtr{};
+}
+
+// The value of an input updated in this batch. Either its param, or
+// for a chained input, a value stored since the input was last read.
+std::optional<yy_maths::ekf::value_type> fresh_value(const ParamVector & p_params,
+                                                     kalman_action_detail::InputMapping & p_input,
+                                                     values::Store & p_values_store) noexcept
+{
+  if(const auto param{find_param(p_params, p_input)};
+     param)
+  {
+    return std::visit([](yy_maths::ekf::value_type value) { return value; }, param->Binary());
+  }
+
+  if(p_input.chained && (values::Store::no_slot != p_input.slot))
+  {
+    if(const auto record{p_values_store.Value(p_input.slot).Load()};
+       record.updates != p_input.updates)
+    {
+      p_input.updates = record.updates;
+
+      return record.value;
+    }
+  }
+
+  return std::nullopt;
+}
+
+// As fresh_value(), without marking a chained input's value as read.
+bool has_fresh_value(const ParamVector & p_params,
+                     const kalman_action_detail::InputMapping & p_input,
+                     const values::Store & p_values_store) noexcept
+{
+  if(find_param(p_params, p_input))
+  {
+    return true;
+  }
+
+  return p_input.chained
+    && (values::Store::no_slot != p_input.slot)
+    && (p_values_store.Value(p_input.slot).Load().updates != p_input.updates);
+}
+
+bool is_stale(const kalman_action_detail::InputMapping & p_input,
+              const values::ValueRecord & p_record,
+              timestamp_type p_timestamp) noexcept
+{
+  return (timestamp_type{} != p_input.max_age)
+    && ((p_timestamp - p_record.timestamp) > p_input.max_age);
+}
+
 } // namespace
 
 KalmanAction::KalmanAction(std::string_view p_id,
                            std::string_view p_output_topic,
                            std::string_view p_output_value_id,
-                           const KalmanOptions & p_options) :
+                           const KalmanOptions & p_options,
+                           KalmanMode p_mode,
+                           KalmanModel p_model,
+                           KalmanBatchesObsPtr p_batches) :
   m_id(std::move(p_id)),
-  m_output_topic(std::move(p_output_topic))
+  m_output_topic(std::move(p_output_topic)),
+  m_mode(p_mode),
+  m_model(p_model),
+  m_states_per_output(kalman_states_per_output(p_model)),
+  m_batches(p_batches)
 {
   auto calc_output_value_id =
     [&p_output_value_id](auto property) -> yy_values::MetricId {
@@ -75,7 +146,7 @@ KalmanAction::KalmanAction(std::string_view p_id,
   // Initialise outputs.
   size_type idx_n = 0;
 
-  for(const auto & [input_id, output_id, _]: p_options)
+  for(const auto & [input_id, output_id, accuracy, max_age]: p_options)
   {
     if(auto output{yy_data::find_iter(m_outputs, output_id)}; !output.found)
     {
@@ -110,7 +181,7 @@ KalmanAction::KalmanAction(std::string_view p_id,
     return comp;
   };
 
-  for(const auto & [input_id, output, _]: p_options)
+  for(const auto & [input_id, output, accuracy, max_age]: p_options)
   {
     if(auto [output_iter, output_found] = yy_data::find_iter(m_outputs, output);
        output_found)
@@ -125,7 +196,7 @@ KalmanAction::KalmanAction(std::string_view p_id,
                      input_id,
                      output_iter->property);
 
-        m_inputs.emplace(input_iter, input_id, idx_m, output_iter->output_idx);
+        m_inputs.emplace(input_iter, input_id, idx_m, output_iter->output_idx, max_age);
         ++idx_m;
       }
     }
@@ -137,7 +208,7 @@ KalmanAction::KalmanAction(std::string_view p_id,
   // Configure measurement noise.
   vector r{m_inputs.size()};
 
-  for(const auto & [input_id, output, accuracy]: p_options)
+  for(const auto & [input_id, output, accuracy, max_age]: p_options)
   {
     if(auto [output_iter, output_found] = yy_data::find_iter(m_outputs, output);
        output_found)
@@ -150,16 +221,140 @@ KalmanAction::KalmanAction(std::string_view p_id,
         auto idx =
           static_cast<vector::size_type>(input_iter - m_inputs.begin());
         r[idx] = accuracy;
+        input_iter->accuracy = accuracy;
         spdlog::debug("   accuracy: input: [{}]=[{}]"sv, input_id, r[idx]);
       }
     }
   }
 
+  const size_type state_count = m_outputs.size() * m_states_per_output;
+
+  std::array<yafiyogi::size_type, g_kalman_fixed_max_inputs> states{};
+  std::array<value_type, g_kalman_fixed_max_inputs> accuracies{};
+  const bool fixed_size = (m_inputs.size() <= g_kalman_fixed_max_inputs)
+                          && (state_count <= g_kalman_fixed_max_states);
+
+  if(fixed_size)
+  {
+    for(const auto & input: m_inputs)
+    {
+      states[input.input_idx] = input.output_idx * m_states_per_output;
+      accuracies[input.input_idx] = input.accuracy;
+    }
+  }
+
+  if(KalmanMode::Batch == m_mode)
+  {
+    if(fixed_size && m_batches)
+    {
+      m_lane = m_batches->Add(state_count,
+                              m_inputs.size(),
+                              states.data(),
+                              accuracies.data(),
+                              EPS,
+                              m_model);
+    }
+
+    if(m_lane.batch)
+    {
+      spdlog::info("    mode: batch [{}x{}] lane [{}]"sv, state_count, m_inputs.size(), m_lane.lane);
+      return;
+    }
+
+    m_mode = KalmanMode::Auto;
+  }
+
+  if((KalmanMode::Auto == m_mode) || (KalmanMode::Fixed == m_mode))
+  {
+    if(fixed_size)
+    {
+      m_fixed = make_kalman_fixed(state_count,
+                                  m_inputs.size(),
+                                  states.data(),
+                                  accuracies.data(),
+                                  EPS,
+                                  m_model);
+    }
+
+    if(m_fixed)
+    {
+      spdlog::info("    mode: fixed [{}x{}]"sv, state_count, m_inputs.size());
+      m_mode = KalmanMode::Fixed;
+      return;
+    }
+
+    // Sequential scales its process noise by the time between runs,
+    // the ekf doesn't, so Matrix is only used when asked for.
+    m_mode = KalmanMode::Sequential;
+  }
+
+  if((KalmanMode::Matrix == m_mode) && (KalmanModel::ConstantVelocity == m_model))
+  {
+    // The ekf only has a fixed random walk predict.
+    spdlog::info("    constant velocity model not supported by matrix mode"sv);
+    m_mode = KalmanMode::Sequential;
+  }
+
+  if(KalmanMode::Sequential == m_mode)
+  {
+    spdlog::info("    mode: sequential"sv);
+    m_sequential = KalmanSequential{state_count, EPS, m_model};
+    return;
+  }
+
   m_ekf = yy_maths::ekf{m_inputs.size(), m_outputs.size(), r};
   m_observations.resize(m_ekf.M());
 
   // Zero mapping sensor-function Jacobian matrix h.
   m_h = zero_matrix{m_ekf.M(), m_ekf.N()};
+  m_hx = zero_vector{m_ekf.M()};
+}
+
+void KalmanAction::BindParams(const ParamIds & p_param_ids) noexcept
+{
+  for(auto & input: m_inputs)
+  {
+    for(size_type param_idx = 0; param_idx < p_param_ids.size(); ++param_idx)
+    {
+      if(0 == input.value_id.compare(yy_values::MetricId{p_param_ids[param_idx]}))
+      {
+        input.param_idx = param_idx;
+        break;
+      }
+    }
+  }
+}
+
+void KalmanAction::BindChained(size_type p_param) noexcept
+{
+  for(auto & input: m_inputs)
+  {
+    if(p_param == input.param_idx)
+    {
+      input.chained = true;
+    }
+  }
+}
+
+void KalmanAction::Resolve(values::Store & p_values_store) noexcept
+{
+  for(auto & input: m_inputs)
+  {
+    input.slot = p_values_store.Resolve(input.value_id);
+    if(values::Store::no_slot == input.slot)
+    {
+      spdlog::warn("  [{}] input [{}] not in values store"sv, m_id, input.value_id);
+    }
+  }
+
+  for(auto & output: m_outputs)
+  {
+    output.slot = p_values_store.Resolve(output.value_id);
+    if(values::Store::no_slot == output.slot)
+    {
+      spdlog::warn("  [{}] output [{}] not in values store"sv, m_id, output.value_id);
+    }
+  }
 }
 
 void KalmanAction::Run(const ParamVector & p_params,
@@ -167,8 +362,100 @@ void KalmanAction::Run(const ParamVector & p_params,
                        values::Store & p_values_store,
                        timestamp_type p_timestamp) noexcept
 {
-  // Zero vector predicted values hx
-  m_hx = zero_vector{m_ekf.M()};
+  const value_type steps = PredictSteps(p_timestamp);
+
+  switch(m_mode)
+  {
+  case KalmanMode::Sequential:
+    RunSequential(p_params, p_values_store, steps);
+    break;
+
+  case KalmanMode::Fixed:
+    RunFixed(p_params, p_values_store, p_timestamp, steps);
+    break;
+
+  case KalmanMode::Batch:
+    // Published by Finish(), once the batch has been stepped.
+    RunBatch(p_params, p_values_store, p_timestamp, steps);
+    return;
+
+  case KalmanMode::Auto:
+    [[fallthrough]];
+  case KalmanMode::Matrix:
+    [[fallthrough]];
+  default:
+    RunMatrix(p_params, p_values_store, p_timestamp);
+    break;
+  }
+
+  Publish(p_results, p_values_store, p_timestamp);
+}
+
+bool KalmanAction::Concurrent() const noexcept
+{
+  // Batch mode adds to the shared KalmanBatches.
+  return KalmanMode::Batch != m_mode;
+}
+
+void KalmanAction::Finish(ActionResultVector & p_results,
+                          values::Store & p_values_store,
+                          timestamp_type p_timestamp) noexcept
+{
+  Publish(p_results, p_values_store, p_timestamp);
+}
+
+void KalmanAction::Publish(ActionResultVector & p_results,
+                           values::Store & p_values_store,
+                           timestamp_type p_timestamp) noexcept
+{
+  m_result.topic = m_output_topic;
+  m_result.data = "{"sv;
+
+  for(auto & output: m_outputs)
+  {
+    auto ekf_Xn = State(output.output_idx);
+
+    if(values::Store::no_slot != output.slot)
+    {
+      p_values_store.Value(output.slot).Store(ekf_Xn, p_timestamp, values::Quality::Derived);
+    }
+
+    fmt::format_to(std::back_inserter(m_result.data),
+                   g_json_property_format,
+                   output.property,
+                   ekf_Xn);
+  }
+
+  fmt::format_to(
+    std::back_inserter(m_result.data),
+    g_timestamp_format,
+    std::chrono::duration_cast<std::chrono::microseconds>(p_timestamp).count());
+
+  spdlog::debug("  result  : json=[{}]"sv, m_result.data);
+
+  p_results.swap_data_back(m_result);
+}
+
+void KalmanAction::RunMatrix(const ParamVector & p_params,
+                             values::Store & p_values_store,
+                             timestamp_type p_timestamp) noexcept
+{
+  // Zero predicted values hx, in place.
+  for(size_type idx = 0; idx < m_ekf.M(); ++idx)
+  {
+    m_hx(idx) = 0.0;
+  }
+
+  if(!AnyFresh(p_params, p_values_store))
+  {
+    // No new values, e.g. a timer run. The stored values have already
+    // been applied, so predict only.
+    spdlog::debug("  previous: [{:.2f}]"sv, m_ekf.X());
+
+    m_ekf.predict();
+    spdlog::debug("  outputs : [{:.2f}]"sv, m_ekf.X());
+    return;
+  }
 
   auto set_observation = [](std::string_view source,
                             const yy_values::MetricId input_value_id,
@@ -180,39 +467,44 @@ void KalmanAction::Run(const ParamVector & p_params,
 
   for(auto & input: m_inputs)
   {
-    if(const auto [param_iter, param_found] =
-         yy_data::find_iter(p_params,
-                            input.value_id,
-                            actions_detail::compare_param);
-       param_found)
+    if(const auto value{fresh_value(p_params, input, p_values_store)};
+       value)
     {
       input.initialized = true;
 
       m_h(input.input_idx, input.output_idx) = 1.0;
       m_hx(input.input_idx) = m_ekf.X(input.output_idx);
-      auto & z = m_observations(input.input_idx);
-
-      auto param_set_observation =
-        [&input, &z, &set_observation](value_type value) {
-          set_observation("parameter"sv, input.value_id, z, value);
-        };
 
-      std::visit(param_set_observation, (*param_iter)->Binary());
+      set_observation("parameter"sv,
+                      input.value_id,
+                      m_observations(input.input_idx),
+                      *value);
     }
-    else if(input.initialized)
+    else if(input.initialized && (values::Store::no_slot != input.slot))
     {
-      auto store_set_observation =
-        [this, &input, &set_observation](auto value) {
-          m_hx(input.input_idx) = m_ekf.X(input.output_idx);
-          auto & z = m_observations(input.input_idx);
-
-          set_observation("store"sv,
-                          input.value_id,
-                          z,
-                          value->load(std::memory_order_acquire));
-        };
-
-      std::ignore = p_values_store.Find(store_set_observation, input.value_id);
+      const auto record{p_values_store.Value(input.slot).Load()};
+
+      if(is_stale(input, record, p_timestamp))
+      {
+        // Drop a stale input from this update. A zero h row adds
+        // nothing to the Kalman gain.
+        spdlog::debug("  stale [{}]"sv, input.value_id);
+
+        m_h(input.input_idx, input.output_idx) = 0.0;
+        m_hx(input.input_idx) = 0.0;
+        m_observations(input.input_idx) = 0.0;
+      }
+      else
+      {
+        m_h(input.input_idx, input.output_idx) = 1.0;
+        m_hx(input.input_idx) = m_ekf.X(input.output_idx);
+        auto & z = m_observations(input.input_idx);
+
+        set_observation("store"sv,
+                        input.value_id,
+                        z,
+                        record.value);
+      }
     }
   }
 
@@ -222,34 +514,146 @@ void KalmanAction::Run(const ParamVector & p_params,
   m_ekf.predict();
   m_ekf.update(m_observations, m_h, m_hx);
   spdlog::debug("  outputs : [{:.2f}]"sv, m_ekf.X());
+}
 
-  m_result.topic = m_output_topic;
-  m_result.data = "{"sv;
+void KalmanAction::RunSequential(const ParamVector & p_params,
+                                 values::Store & p_values_store,
+                                 value_type p_steps) noexcept
+{
+  m_sequential.Predict(p_steps);
 
-  for(auto & output: m_outputs)
+  for(auto & input: m_inputs)
+  {
+    if(const auto value{fresh_value(p_params, input, p_values_store)};
+       value)
+    {
+      input.initialized = true;
+
+      spdlog::debug("  parameter [{}] value [{:.2f}]"sv, input.value_id, *value);
+      m_sequential.Update(input.output_idx * m_states_per_output, *value, input.accuracy);
+    }
+  }
+
+  spdlog::debug("  outputs : [{:.2f}]"sv, fmt::join(m_sequential.X(), ", "sv));
+}
+
+bool KalmanAction::AnyFresh(const ParamVector & p_params,
+                            const values::Store & p_values_store) const noexcept
+{
+  return std::any_of(m_inputs.begin(), m_inputs.end(), [&p_params, &p_values_store](const auto & p_input) {
+    return has_fresh_value(p_params, p_input, p_values_store);
+  });
+}
+
+template<typename Observe>
+void KalmanAction::CollectObservations(const ParamVector & p_params,
+                                       values::Store & p_values_store,
+                                       timestamp_type p_timestamp,
+                                       Observe && p_observe) noexcept
+{
+  if(!AnyFresh(p_params, p_values_store))
   {
-    auto ekf_Xn = m_ekf.X(output.output_idx);
+    // No new values, predict only. See RunMatrix().
+    return;
+  }
 
-    auto add_value_to_store = [&ekf_Xn](auto p_value) {
-      p_value->store(ekf_Xn, std::memory_order_release);
-    };
+  for(auto & input: m_inputs)
+  {
+    if(const auto value{fresh_value(p_params, input, p_values_store)};
+       value)
+    {
+      input.initialized = true;
 
-    std::ignore = p_values_store.Find(add_value_to_store, output.value_id);
+      spdlog::debug("  parameter [{}] value [{:.2f}]"sv, input.value_id, *value);
+      p_observe(input.input_idx, *value);
+    }
+    else if(input.initialized && (values::Store::no_slot != input.slot))
+    {
+      if(const auto record{p_values_store.Value(input.slot).Load()};
+         is_stale(input, record, p_timestamp))
+      {
+        spdlog::debug("  stale [{}]"sv, input.value_id);
+      }
+      else
+      {
+        spdlog::debug("  store [{}] value [{:.2f}]"sv, input.value_id, record.value);
+        p_observe(input.input_idx, record.value);
+      }
+    }
+  }
+}
 
-    fmt::format_to(std::back_inserter(m_result.data),
-                   g_json_property_format,
-                   output.property,
-                   ekf_Xn);
+void KalmanAction::RunFixed(const ParamVector & p_params,
+                            values::Store & p_values_store,
+                            timestamp_type p_timestamp,
+                            value_type p_steps) noexcept
+{
+  CollectObservations(p_params,
+                      p_values_store,
+                      p_timestamp,
+                      [this](size_type p_input, value_type p_z) {
+                        m_fixed->Observe(p_input, p_z);
+                      });
+
+  m_fixed->Step(p_steps);
+}
+
+void KalmanAction::RunBatch(const ParamVector & p_params,
+                            values::Store & p_values_store,
+                            timestamp_type p_timestamp,
+                            value_type p_steps) noexcept
+{
+  CollectObservations(p_params,
+                      p_values_store,
+                      p_timestamp,
+                      [this](size_type p_input, value_type p_z) {
+                        m_lane.batch->Observe(m_lane.lane, p_input, p_z);
+                      });
+
+  m_lane.batch->Trigger(m_lane.lane, p_steps);
+  m_batches->Pending(ActionObsPtr{this});
+}
+
+KalmanAction::value_type KalmanAction::PredictSteps(timestamp_type p_timestamp) noexcept
+{
+  // Process noise is per g_predict_interval, so scale it by the time
+  // since the last run. The first run predicts one interval.
+  value_type steps = 1.0;
+
+  if(timestamp_type{} != m_last_run)
+  {
+    steps = std::max(0.0,
+                     std::chrono::duration<value_type>{p_timestamp - m_last_run}
+                     / std::chrono::duration<value_type>{g_predict_interval});
   }
 
-  fmt::format_to(
-    std::back_inserter(m_result.data),
-    g_timestamp_format,
-    std::chrono::duration_cast<std::chrono::microseconds>(p_timestamp).count());
+  m_last_run = p_timestamp;
 
-  spdlog::debug("  result  : json=[{}]"sv, m_result.data);
+  return steps;
+}
 
-  p_results.swap_data_back(m_result);
+KalmanAction::value_type KalmanAction::State(size_type p_idx) noexcept
+{
+  switch(m_mode)
+  {
+  case KalmanMode::Sequential:
+    return m_sequential.X(p_idx * m_states_per_output);
+
+  case KalmanMode::Fixed:
+    return m_fixed->X(p_idx * m_states_per_output);
+
+  case KalmanMode::Batch:
+    return m_lane.batch->X(m_lane.lane, p_idx * m_states_per_output);
+
+  case KalmanMode::Auto:
+    [[fallthrough]];
+  case KalmanMode::Matrix:
+    [[fallthrough]];
+  default:
+    break;
+  }
+
+  return m_ekf.X(p_idx);
 }
 
 const std::string_view KalmanAction::Id() const noexcept
@@ -26,6 +26,8 @@
 
 #pragma once
 
+#include <cstdint>
+#include <limits>
 #include <string>
 #include <string_view>
 
@@ -35,6 +37,11 @@
 #include "yy_values/yy_values_metric_id.hpp"
 
 #include "action.hpp"
+#include "kalman_batch.hpp"
+#include "kalman_fixed.hpp"
+#include "kalman_model.hpp"
+#include "kalman_sequential.hpp"
+#include "values_store.hpp"
 
 namespace yafiyogi::actions {
 namespace kalman_action_detail {
@@ -54,6 +61,7 @@ struct OutputMapping
     std::string property{};
     yy_values::MetricId value_id{};
     size_type output_idx = 0;
+    values::Store::slot_type slot = values::Store::no_slot;
 };
 
 struct InputMapping
@@ -71,7 +79,16 @@ struct InputMapping
     yy_values::MetricId value_id{};
     size_type input_idx = 0;
     size_type output_idx = 0;
+    timestamp_type max_age{};
+    yy_maths::ekf::value_type accuracy{yy_maths::ekf::EPS};
+    values::Store::slot_type slot = values::Store::no_slot;
+    size_type param_idx = no_param;
+    // Updates of a chained input's store slot when it was last read.
+    std::uint64_t updates = 0;
     bool initialized = false;
+    bool chained = false;
+
+    static constexpr size_type no_param = std::numeric_limits<size_type>::max();
 
     static int compare(const InputMapping & mapping,
                        const yy_values::MetricId & id)
@@ -87,6 +104,8 @@ struct KalmanOption
     yy_values::MetricId input{};
     std::string output{};
     yy_maths::ekf::value_type accuracy{yy_maths::ekf::EPS};
+    // Stored values older than this aren't used. Zero means no limit.
+    timestamp_type max_age{};
 
     static int compare(const KalmanOption & option,
                        const yy_values::MetricId & id)
@@ -97,6 +116,17 @@ struct KalmanOption
 
 using KalmanOptions = yy_quad::simple_vector<KalmanOption>;
 
+// Auto: Fixed if there is a fixed size kernel for the number of states
+//       & inputs, otherwise Sequential.
+// Matrix: one ekf update of every input, using stored values for inputs
+//         not in the current batch. Its predict adds the same process
+//         noise whatever the time between runs.
+// Sequential: a scalar update for each input in the current batch.
+// Fixed: the inputs of Matrix, on a fixed size kernel.
+// Batch: the inputs of Matrix, stepped with all the filters of the same
+//        shape by KalmanBatches. Falls back to Auto for other shapes.
+enum class KalmanMode:uint8_t {Auto, Matrix, Sequential, Fixed, Batch};
+
 class KalmanAction final:
       public Action
 {
@@ -110,11 +140,22 @@ class KalmanAction final:
     KalmanAction(std::string_view p_id,
                  std::string_view p_output_topic,
                  std::string_view p_output_value_id,
-                 const KalmanOptions & p_options);
+                 const KalmanOptions & p_options,
+                 KalmanMode p_mode = KalmanMode::Auto,
+                 KalmanModel p_model = KalmanModel::RandomWalk,
+                 KalmanBatchesObsPtr p_batches = KalmanBatchesObsPtr{});
+    void BindParams(const ParamIds & p_param_ids) noexcept override;
+    void BindChained(size_type p_param) noexcept override;
+    void Resolve(values::Store & p_values_store) noexcept override;
     void Run(const ParamVector & p_params,
              ActionResultVector & p_results,
              values::Store & p_values_store,
              timestamp_type p_timestamp) noexcept override;
+    void Finish(ActionResultVector & p_results,
+                values::Store & p_values_store,
+                timestamp_type p_timestamp) noexcept override;
+    [[nodiscard]]
+    bool Concurrent() const noexcept override;
 
     const std::string_view Id() const noexcept override;
     const std::string_view Name() const noexcept override;
@@ -125,10 +166,55 @@ class KalmanAction final:
     using vector = ekf::vector;
     using zero_vector = ekf::zero_vector;
 
+    void RunMatrix(const ParamVector & p_params,
+                   values::Store & p_values_store,
+                   timestamp_type p_timestamp) noexcept;
+    void RunSequential(const ParamVector & p_params,
+                       values::Store & p_values_store,
+                       value_type p_steps) noexcept;
+    void RunFixed(const ParamVector & p_params,
+                  values::Store & p_values_store,
+                  timestamp_type p_timestamp,
+                  value_type p_steps) noexcept;
+    void RunBatch(const ParamVector & p_params,
+                  values::Store & p_values_store,
+                  timestamp_type p_timestamp,
+                  value_type p_steps) noexcept;
+    // Predict intervals since the last run.
+    [[nodiscard]]
+    value_type PredictSteps(timestamp_type p_timestamp) noexcept;
+    // True if an input has a value in p_params or, for a chained input,
+    // a newly stored value. Stored values of the other inputs are only
+    // re-applied alongside a fresh value, so timer runs predict only.
+    [[nodiscard]]
+    bool AnyFresh(const ParamVector & p_params,
+                  const values::Store & p_values_store) const noexcept;
+    // Calls p_observe(input_idx, z) for each input in p_params & each
+    // initialized input with a fresh stored value, if any input is
+    // fresh (see AnyFresh()).
+    template<typename Observe>
+    void CollectObservations(const ParamVector & p_params,
+                             values::Store & p_values_store,
+                             timestamp_type p_timestamp,
+                             Observe && p_observe) noexcept;
+    void Publish(ActionResultVector & p_results,
+                 values::Store & p_values_store,
+                 timestamp_type p_timestamp) noexcept;
+    [[nodiscard]]
+    value_type State(size_type p_idx) noexcept;
+
     std::string m_id;
     std::string m_output_topic{};
+    KalmanMode m_mode = KalmanMode::Matrix;
+    KalmanModel m_model = KalmanModel::RandomWalk;
+    size_type m_states_per_output = 1;
+    timestamp_type m_last_run{};
 
     ekf m_ekf{};
+    KalmanSequential m_sequential{};
+    KalmanKernelPtr m_fixed{};
+    KalmanBatchesObsPtr m_batches{};
+    KalmanBatches::Lane m_lane{};
     vector m_observations{};
     matrix m_h{};
     vector m_hx{};
@@ -0,0 +1,195 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <algorithm>
+#include <condition_variable>
+#include <mutex>
+
+#include "spdlog/spdlog.h"
+
+#include "action_scheduler.hpp"
+
+namespace yafiyogi::mendel {
+
+using namespace std::string_view_literals;
+
+namespace {
+
+// Whole ticks in a duration, at least one.
+TimerWheel::tick_type to_ticks(timestamp_type p_duration) noexcept
+{
+  const timestamp_type tick{ActionScheduler::g_tick};
+
+  return std::max(TimerWheel::tick_type{1},
+                  static_cast<TimerWheel::tick_type>((p_duration + tick - timestamp_type{1}) / tick));
+}
+
+timestamp_type now() noexcept
+{
+  return timestamp_type{std::chrono::time_point_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now()).time_since_epoch()};
+}
+
+} // anonymous namespace
+
+ActionScheduler::ActionScheduler(const actions::Store & p_actions_store,
+                                 actions::ActionTimerQueueWriter && p_queue_out,
+                                 QueueDoorbellPtr p_doorbell):
+  m_actions_store(p_actions_store),
+  m_queue_out(std::move(p_queue_out)),
+  m_doorbell(std::move(p_doorbell))
+{
+  for(size_type action_idx = 0; action_idx < m_actions_store.ActionCount(); ++action_idx)
+  {
+    const auto & schedule = m_actions_store.Schedule(action_idx);
+
+    if(timestamp_type{} != schedule.period)
+    {
+      AddTimer(action_idx, TimerType::Period, schedule.period);
+    }
+
+    if(timestamp_type{} != schedule.idle)
+    {
+      AddTimer(action_idx, TimerType::Idle, schedule.idle);
+    }
+  }
+
+  m_fired.reserve(m_timers.size());
+
+  spdlog::debug("  action scheduler: [{}] timers"sv, m_timers.size());
+}
+
+void ActionScheduler::AddTimer(size_type p_action,
+                               TimerType p_type,
+                               timestamp_type p_interval)
+{
+  const timer_id timer = m_wheel.Create();
+  const tick_type interval = to_ticks(p_interval);
+
+  m_timers.emplace_back(Timer{p_action, p_type, interval, p_interval});
+  m_wheel.Schedule(timer, m_wheel.Now() + interval);
+}
+
+void ActionScheduler::Run(std::stop_token p_stop_token)
+{
+  std::mutex l_mutex;
+  std::condition_variable_any l_wake;
+
+  const auto start = std::chrono::steady_clock::now();
+  auto next_tick = start;
+
+  while(!p_stop_token.stop_requested())
+  {
+    next_tick += g_tick;
+
+    {
+      std::unique_lock lock{l_mutex};
+      std::ignore = l_wake.wait_until(lock, p_stop_token, next_tick, [] { return false; });
+    }
+
+    if(p_stop_token.stop_requested())
+    {
+      break;
+    }
+
+    const tick_type now_tick = static_cast<tick_type>((std::chrono::steady_clock::now() - start) / g_tick);
+    const timestamp_type timestamp = now();
+
+    m_wheel.Advance(now_tick, [this, now_tick, timestamp](timer_id p_timer, tick_type p_expiry) {
+      Expired(p_timer, p_expiry, now_tick, timestamp);
+    });
+
+    if(!m_fired.empty())
+    {
+      if(m_queue_out.QSwapIn(m_fired))
+      {
+        m_doorbell->Ring();
+        m_fired.clear(yy_data::ClearAction::Keep);
+        m_fired_waiting = false;
+      }
+      else if(!m_fired_waiting)
+      {
+        // The actions thread is behind. Keep the fired actions & send
+        // them on a later tick.
+        spdlog::warn("Action timer queue full, [{}] fired actions waiting."sv, m_fired.size());
+        m_fired_waiting = true;
+      }
+    }
+  }
+}
+
+void ActionScheduler::Fire(size_type p_action) noexcept
+{
+  // Fired actions wait while the queue is full, so an action may fire
+  // again before they are sent.
+  if(m_fired.end() == std::find(m_fired.begin(), m_fired.end(), p_action))
+  {
+    m_fired.emplace_back(p_action);
+  }
+}
+
+void ActionScheduler::Expired(timer_id p_timer,
+                              tick_type p_expiry,
+                              tick_type p_now,
+                              timestamp_type p_timestamp) noexcept
+{
+  const auto & timer = m_timers[p_timer];
+
+  switch(timer.type)
+  {
+  case TimerType::Idle:
+    // Timers aren't moved each time an action runs. Instead an idle
+    // timer that expires after a run waits for the rest of the timeout.
+    if(const timestamp_type since_run = p_timestamp - m_actions_store.LastRun(timer.action);
+       since_run < timer.idle)
+    {
+      m_wheel.Schedule(p_timer, p_now + to_ticks(timer.idle - since_run));
+      return;
+    }
+
+    Fire(timer.action);
+    m_wheel.Schedule(p_timer, p_now + timer.interval);
+    break;
+
+  case TimerType::Period:
+    [[fallthrough]];
+  default:
+    Fire(timer.action);
+
+    // Keep to the period, skipping missed runs.
+    if(const tick_type next = p_expiry + timer.interval;
+       next > p_now)
+    {
+      m_wheel.Schedule(p_timer, next);
+    }
+    else
+    {
+      m_wheel.Schedule(p_timer, p_now + timer.interval);
+    }
+    break;
+  }
+}
+
+} // namespace yafiyogi::mendel
@@ -0,0 +1,100 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <chrono>
+#include <cstdint>
+#include <memory>
+#include <stop_token>
+#include <vector>
+
+#include "yy_cpp/yy_types.hpp"
+
+#include "action_timer_queue.hpp"
+#include "actions_store.hpp"
+#include "queue_doorbell.hpp"
+#include "timer_wheel.hpp"
+
+namespace yafiyogi::mendel {
+
+// Runs the timers of the actions' schedules on a timer wheel. The
+// actions of expired timers are sent to the actions handler, which runs
+// them with empty params.
+class ActionScheduler
+{
+  public:
+    // Timer resolution.
+    static constexpr std::chrono::milliseconds g_tick{100};
+
+    ActionScheduler(const actions::Store & p_actions_store,
+                    actions::ActionTimerQueueWriter && p_queue_out,
+                    QueueDoorbellPtr p_doorbell);
+    void Run(std::stop_token p_stop_token);
+
+    // True when no action has a schedule.
+    [[nodiscard]]
+    bool empty() const noexcept
+    {
+      return m_timers.empty();
+    }
+
+  private:
+    using tick_type = TimerWheel::tick_type;
+    using timer_id = TimerWheel::timer_id;
+
+    enum class TimerType:uint8_t {Period, Idle};
+
+    struct Timer final
+    {
+        size_type action = 0;
+        TimerType type = TimerType::Period;
+        tick_type interval = 1;
+        timestamp_type idle{};
+    };
+
+    void AddTimer(size_type p_action,
+                  TimerType p_type,
+                  timestamp_type p_interval);
+    void Fire(size_type p_action) noexcept;
+    void Expired(timer_id p_timer,
+                 tick_type p_expiry,
+                 tick_type p_now,
+                 timestamp_type p_timestamp) noexcept;
+
+    const actions::Store & m_actions_store;
+    actions::ActionTimerQueueWriter m_queue_out{};
+    QueueDoorbellPtr m_doorbell{};
+    TimerWheel m_wheel{};
+    // Indexed by timer id.
+    std::vector<Timer> m_timers{};
+    actions::TimerActions m_fired{};
+    bool m_fired_waiting = false;
+};
+
+using ActionSchedulerPtr = std::shared_ptr<ActionScheduler>;
+
+} // namespace yafiyogi::mendel
@@ -0,0 +1,204 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <algorithm>
+
+#include "spdlog/spdlog.h"
+
+#include "allocation_counter.hpp"
+
+#include "action_workers.hpp"
+
+namespace yafiyogi::mendel {
+
+using namespace std::string_view_literals;
+
+ActionWorkers::ActionWorkers(size_type p_worker_count,
+                             actions::Store & p_actions_store,
+                             values::Store & p_values_store,
+                             ActionParamsVector & p_params):
+  m_worker_count(std::max(size_type{1}, p_worker_count)),
+  m_actions_store(p_actions_store),
+  m_values_store(p_values_store),
+  m_params(p_params),
+  m_workers(std::make_unique<Worker[]>(m_worker_count))
+{
+  // Worker 0 is the calling thread.
+  m_threads.reserve(m_worker_count - 1);
+  for(size_type worker = 1; worker < m_worker_count; ++worker)
+  {
+    m_threads.emplace_back([this, worker]() {
+      WorkerThread(worker);
+    });
+  }
+}
+
+ActionWorkers::~ActionWorkers() noexcept
+{
+  m_stop.store(true, std::memory_order_relaxed);
+  m_generation.fetch_add(1, std::memory_order_release);
+  m_generation.notify_all();
+
+  for(auto & thread : m_threads)
+  {
+    thread.join();
+  }
+}
+
+void ActionWorkers::Run(const ActionIndexes & p_actions,
+                        actions::ActionResultVector & p_results,
+                        timestamp_type p_timestamp) noexcept
+{
+  const size_type action_count = p_actions.size();
+
+  if((1 == m_worker_count) || (action_count < 2))
+  {
+    for(const size_type action_idx : p_actions)
+    {
+      RunAction(action_idx, p_results, p_timestamp);
+    }
+    return;
+  }
+
+  // Give each worker an equal share of the actions.
+  const size_type share = action_count / m_worker_count;
+  const size_type extra = action_count % m_worker_count;
+  size_type begin = 0;
+  for(size_type worker_idx = 0; worker_idx < m_worker_count; ++worker_idx)
+  {
+    auto & worker = m_workers[worker_idx];
+    const size_type end = begin + share + (worker_idx < extra ? 1 : 0);
+
+    worker.next.store(begin, std::memory_order_relaxed);
+    worker.end = end;
+    worker.results.clear(yy_data::ClearAction::Keep);
+    begin = end;
+  }
+
+  m_actions = &p_actions;
+  m_timestamp = p_timestamp;
+  m_busy.store(m_worker_count - 1, std::memory_order_relaxed);
+
+  m_generation.fetch_add(1, std::memory_order_release);
+  m_generation.notify_all();
+
+  Work(0);
+
+  for(size_type busy = m_busy.load(std::memory_order_acquire); 0 != busy; busy = m_busy.load(std::memory_order_acquire))
+  {
+    m_busy.wait(busy, std::memory_order_acquire);
+  }
+
+  for(size_type worker_idx = 0; worker_idx < m_worker_count; ++worker_idx)
+  {
+    for(auto & result : m_workers[worker_idx].results)
+    {
+      p_results.swap_data_back(result);
+    }
+  }
+}
+
+void ActionWorkers::RunAction(size_type p_action_idx,
+                              actions::ActionResultVector & p_results,
+                              timestamp_type p_timestamp) noexcept
+{
+  auto & action = m_actions_store.GetAction(p_action_idx);
+  auto & params = m_params[p_action_idx];
+
+  spdlog::debug("Processing action=[{}] id=[{}]"sv,
+                action.Name(),
+                action.Id());
+  action.Run(params, p_results, m_values_store, p_timestamp);
+
+  std::fill(params.begin(), params.end(), yy_values::MetricDataObsPtr{});
+  m_actions_store.Ran(p_action_idx, p_timestamp);
+}
+
+size_type ActionWorkers::Allocations() const noexcept
+{
+  // Worker 0's allocations are counted by the calling thread.
+  size_type allocations = 0;
+  for(size_type worker_idx = 1; worker_idx < m_worker_count; ++worker_idx)
+  {
+    allocations += m_workers[worker_idx].allocations;
+  }
+
+  return allocations;
+}
+
+void ActionWorkers::Work(size_type p_worker) noexcept
+{
+  auto & results = m_workers[p_worker].results;
+
+  // Own share first, then steal from the others.
+  for(size_type offset = 0; offset < m_worker_count; ++offset)
+  {
+    Drain(m_workers[(p_worker + offset) % m_worker_count], results);
+  }
+}
+
+void ActionWorkers::Drain(Worker & p_worker,
+                          actions::ActionResultVector & p_results) noexcept
+{
+  // The owner & thieves claim actions from the same counter, so each
+  // action is run once.
+  for(size_type idx = p_worker.next.fetch_add(1, std::memory_order_relaxed);
+      idx < p_worker.end;
+      idx = p_worker.next.fetch_add(1, std::memory_order_relaxed))
+  {
+    RunAction((*m_actions)[idx], p_results, m_timestamp);
+  }
+}
+
+void ActionWorkers::WorkerThread(size_type p_worker) noexcept
+{
+  std::uint64_t generation = 0;
+
+  while(true)
+  {
+    m_generation.wait(generation, std::memory_order_acquire);
+    generation = m_generation.load(std::memory_order_acquire);
+
+    if(m_stop.load(std::memory_order_relaxed))
+    {
+      return;
+    }
+
+    const size_type allocations = allocation_count();
+
+    Work(p_worker);
+
+    // Published to the calling thread by the release of m_busy.
+    m_workers[p_worker].allocations += allocation_count() - allocations;
+
+    if(1 == m_busy.fetch_sub(1, std::memory_order_acq_rel))
+    {
+      m_busy.notify_one();
+    }
+  }
+}
+
+} // namespace yafiyogi::mendel
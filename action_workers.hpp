@@ -0,0 +1,117 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <thread>
+
+#include "yy_cpp/yy_types.hpp"
+#include "yy_cpp/yy_vector.h"
+
+#include "action.hpp"
+#include "action_result.hpp"
+#include "actions_store.hpp"
+#include "values_store.hpp"
+
+namespace yafiyogi::mendel {
+
+using ActionParamsVector = yy_quad::simple_vector<actions::ParamVector>;
+using ActionIndexes = yy_quad::simple_vector<size_type>;
+
+// Runs the actions of a batch on a pool of threads. Each worker starts
+// with an equal share of the actions & steals from the others when it
+// runs out. Each worker has its own results, merged when all are done.
+class ActionWorkers final
+{
+  public:
+    ActionWorkers(size_type p_worker_count,
+                  actions::Store & p_actions_store,
+                  values::Store & p_values_store,
+                  ActionParamsVector & p_params);
+    ~ActionWorkers() noexcept;
+
+    ActionWorkers() = delete;
+    ActionWorkers(const ActionWorkers &) = delete;
+    ActionWorkers(ActionWorkers &&) = delete;
+
+    ActionWorkers & operator=(const ActionWorkers &) = delete;
+    ActionWorkers & operator=(ActionWorkers &&) = delete;
+
+    // Run p_actions, the calling thread being one of the workers. The
+    // results are added to p_results.
+    void Run(const ActionIndexes & p_actions,
+             actions::ActionResultVector & p_results,
+             timestamp_type p_timestamp) noexcept;
+
+    // Run one action on the calling thread.
+    void RunAction(size_type p_action_idx,
+                   actions::ActionResultVector & p_results,
+                   timestamp_type p_timestamp) noexcept;
+
+    // Allocations made by the worker threads so far (see
+    // allocation_counter.hpp). Only read between calls to Run().
+    [[nodiscard]]
+    size_type Allocations() const noexcept;
+
+    [[nodiscard]]
+    constexpr size_type WorkerCount() const noexcept
+    {
+      return m_worker_count;
+    }
+
+  private:
+    struct alignas(values::g_cache_line_size) Worker final
+    {
+        std::atomic<size_type> next{0};
+        size_type end = 0;
+        size_type allocations = 0;
+        actions::ActionResultVector results{};
+    };
+
+    void Work(size_type p_worker) noexcept;
+    void Drain(Worker & p_worker,
+               actions::ActionResultVector & p_results) noexcept;
+    void WorkerThread(size_type p_worker) noexcept;
+
+    size_type m_worker_count = 1;
+    actions::Store & m_actions_store;
+    values::Store & m_values_store;
+    ActionParamsVector & m_params;
+    std::unique_ptr<Worker[]> m_workers;
+
+    const ActionIndexes * m_actions = nullptr;
+    timestamp_type m_timestamp{};
+    std::atomic<std::uint64_t> m_generation{0};
+    std::atomic<size_type> m_busy{0};
+    std::atomic<bool> m_stop{false};
+
+    yy_quad::simple_vector<std::jthread> m_threads{};
+};
+
+} // namespace yafiyogi::mendel
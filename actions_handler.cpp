@@ -24,15 +24,21 @@
 
 */
 
+#include <algorithm>
+#include <bit>
 #include <chrono>
+#include <cstdint>
+#include <utility>
+#include <vector>
 
 #include "spdlog/spdlog.h"
 
-#include "yy_cpp/yy_find_raw_util.hpp"
 #include "yy_values/yy_values_metric_id_fmt.hpp"
 #include "yy_values/yy_values_metric_labels.hpp"
 #include "action.hpp"
+#include "action_workers.hpp"
 #include "actions_handler.hpp"
+#include "allocation_counter.hpp"
 
 namespace yafiyogi::mendel {
 
@@ -40,137 +46,227 @@ using namespace std::string_view_literals;
 
 namespace {
 
-class NullAction final:
-      public actions::Action
-{
-  public:
-    void Run(const actions::ParamVector & /* params */,
-             actions::ActionResultVector & /* p_results */,
-             values::Store & /* store */,
-             timestamp_type /* timestamp */) noexcept override
-    {
-    }
-
-    const std::string_view Id() const noexcept override
-    {
-      return "(null)"sv;
-    }
-
-    const std::string_view Name() const noexcept override
-    {
-      return "Null Action"sv;
-    }
-};
-
-NullAction null_action;
-actions::ActionObsPtr g_null_action{&null_action};
-
 constexpr size_type spin_max = 400;
 
-struct ActionValue final
+// A bit per action, set when a batch triggers the action.
+class TriggeredActions final
 {
-    bool operator<(const actions::ActionObsPtr & p_action) const noexcept
+  public:
+    explicit TriggeredActions(size_type p_action_count):
+      m_words((p_action_count + word_bits - 1) / word_bits, 0)
     {
-      return action < p_action;
     }
 
-    bool operator==(const actions::ActionObsPtr & p_action) const noexcept
+    void Set(size_type p_action) noexcept
     {
-      return action == p_action;
+      m_words[p_action / word_bits] |= word_type{1} << (p_action % word_bits);
     }
 
-    void Run(values::Store & p_value_store,
-             actions::ActionResultVector & p_results,
-             timestamp_type timestamp)
+    // Visit the triggered actions in [p_begin, p_end) in index order,
+    // clearing them.
+    template<typename Visitor>
+    void Visit(size_type p_begin,
+               size_type p_end,
+               Visitor && p_visitor)
     {
-      spdlog::debug("Processing action=[{}] id=[{}]",
-                    action->Name(),
-                    action->Id());
-      action->Run(params, p_results, p_value_store, timestamp);
+      for(size_type idx = p_begin; idx < p_end;)
+      {
+        const size_type word_idx = idx / word_bits;
+        const size_type first = idx % word_bits;
+        const size_type last = std::min(word_bits, p_end - (word_idx * word_bits));
+        const word_type mask = (~word_type{0} << first)
+          & (word_bits == last ? ~word_type{0} : ((word_type{1} << last) - 1));
+
+        for(word_type word = m_words[word_idx] & mask; 0 != word; word &= word - 1)
+        {
+          p_visitor((word_idx * word_bits) + static_cast<size_type>(std::countr_zero(word)));
+        }
+        m_words[word_idx] &= ~mask;
+
+        idx = (word_idx * word_bits) + last;
+      }
     }
 
-    actions::ActionObsPtr action = g_null_action;
-    actions::ParamVector params{};
-};
+  private:
+    using word_type = std::uint64_t;
+    static constexpr size_type word_bits = 64;
 
-using ActionValueVector = yy_quad::simple_vector<ActionValue>;
+    std::vector<word_type> m_words;
+};
 
 } // anonymous namespace
 
 ActionsHandler::ActionsHandler(actions::StorePtr p_actions_store,
                                values::StorePtr p_values_store,
                                values::MetricDataQueueReader && p_queue_in,
-                               actions::ActionResultQueueWriter && p_queue_out):
+                               actions::ActionTimerQueueReader && p_timers_in,
+                               QueueDoorbellPtr p_doorbell,
+                               actions::ActionResultQueueWriter && p_queue_out,
+                               size_type p_worker_count):
   m_actions_store(std::move(p_actions_store)),
   m_values_store(std::move(p_values_store)),
   m_queue_in(std::move(p_queue_in)),
-  m_queue_out(std::move(p_queue_out))
+  m_timers_in(std::move(p_timers_in)),
+  m_doorbell(std::move(p_doorbell)),
+  m_queue_out(std::move(p_queue_out)),
+  m_worker_count(p_worker_count)
 {
+  m_actions_store->Resolve(*m_values_store);
 }
 
 void ActionsHandler::Run(std::stop_token p_stop_token)
 {
   yy_values::MetricDataVector l_data_in;
+  actions::TimerActions l_timers_in;
 
   actions::Store & l_actions_store = *m_actions_store;
   values::Store & l_values_store = *m_values_store;
+  const size_type action_count = l_actions_store.ActionCount();
 
   size_type spin = 1; // Set to 1 to prevent spinning at startup.
 
   actions::ActionResultVector l_action_values{};
-  ActionValueVector l_actions{};
+
+  // The params of every action, sized once. A batch writes the params
+  // of the actions it triggers straight in to their slots.
+  ActionParamsVector l_params{};
+  l_params.reserve(action_count);
+  for(size_type action_idx = 0; action_idx < action_count; ++action_idx)
+  {
+    actions::ParamVector params{};
+    const size_type param_count = l_actions_store.ParamCount(action_idx);
+
+    params.reserve(param_count);
+    for(size_type param_idx = 0; param_idx < param_count; ++param_idx)
+    {
+      params.emplace_back(yy_values::MetricDataObsPtr{});
+    }
+
+    l_params.emplace_back(std::move(params));
+  }
+
+  TriggeredActions l_triggered{action_count};
+  ActionWorkers l_workers{m_worker_count, l_actions_store, l_values_store, l_params};
+  ActionIndexes l_level{};
+  l_level.reserve(action_count);
+  ActionIndexes l_concurrent{};
+  l_concurrent.reserve(action_count);
+  size_type batch_count = 0;
 
   while(!p_stop_token.stop_requested())
   {
-    while(m_queue_in.QSwapOut(l_data_in))
+    const bool data_in = m_queue_in.QSwapOut(l_data_in);
+    const bool timers_in = m_timers_in.QSwapOut(l_timers_in);
+
+    if(data_in || timers_in)
     {
       spin = spin_max; // Reset spin count.
 
+      const size_type allocations = allocation_count() + l_workers.Allocations();
+
       l_action_values.clear(yy_data::ClearAction::Keep);
-      l_actions.clear(yy_data::ClearAction::Keep);
 
-      for(auto & data : l_data_in)
+      if(!data_in)
       {
-        auto add_actions_n_data = [&data, &l_actions](actions::Store::value_ptr actions) {
-          for(auto action : *actions)
-          {
-            auto [action_pos, action_found] = yy_data::find_raw_pos(l_actions, action);
-            auto action_iter = l_actions.data() + action_pos;
+        l_data_in.clear(yy_data::ClearAction::Keep);
+      }
 
-            if(!action_found)
-            {
-              auto [iter, _] = l_actions.emplace(l_actions.begin() + action_pos, action, actions::ParamVector{});
-              action_iter = l_actions.data() + (iter - l_actions.begin());
-            }
+      if(!timers_in)
+      {
+        l_timers_in.clear(yy_data::ClearAction::Keep);
+      }
 
-            auto & params = action_iter->params;
+      // Actions run by a timer have empty params.
+      for(const size_type action_idx : l_timers_in)
+      {
+        l_triggered.Set(action_idx);
+      }
 
-            if(auto [param_iter, param_found] = yy_data::find_raw(params, data.Id(), actions::actions_detail::compare_param);
-               !param_found)
+      for(auto & data : l_data_in)
+      {
+        auto set_params = [&data, &l_params, &l_triggered](actions::Store::value_ptr p_action_params) {
+          for(const auto & [action_idx, param_idx] : *p_action_params)
+          {
+            // The latest value of a metric in a batch is used, e.g. the
+            // newest sample of a samples payload, matching the store.
+            if(auto & param = l_params[action_idx][param_idx];
+               !param || (data.Timestamp() >= param->Timestamp()))
             {
-              yy_values::MetricDataObsPtr param{&data};
-
-              params.emplace(params.begin() + (param_iter - params.data()), param);
+              param = yy_values::MetricDataObsPtr{&data};
             }
+
+            l_triggered.Set(action_idx);
           }
         };
 
-        std::ignore = l_actions_store.Find(add_actions_n_data, data.Id());
+        std::ignore = l_actions_store.Find(set_params, data.Id());
       }
 
       timestamp_type timestamp{std::chrono::time_point_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now()).time_since_epoch()};
-      for(auto & action : l_actions)
+
+      // Levels run in order, so actions chained to another action's
+      // outputs run after it in the same batch.
+      size_type level_begin = 0;
+      for(const size_type level_end : l_actions_store.LevelEnds())
       {
-        action.Run(l_values_store, l_action_values, timestamp);
+        // Actions that can't run on a worker are run as they're found,
+        // the rest are shared between the workers.
+        l_level.clear(yy_data::ClearAction::Keep);
+        l_concurrent.clear(yy_data::ClearAction::Keep);
+        l_triggered.Visit(level_begin, level_end, [&l_actions_store, &l_workers, &l_level, &l_concurrent, &l_action_values, timestamp](size_type p_action_idx) {
+          l_level.emplace_back(p_action_idx);
+
+          if(l_actions_store.GetAction(p_action_idx).Concurrent())
+          {
+            l_concurrent.emplace_back(p_action_idx);
+          }
+          else
+          {
+            l_workers.RunAction(p_action_idx, l_action_values, timestamp);
+          }
+        });
+
+        level_begin = level_end;
+
+        if(l_level.empty())
+        {
+          continue;
+        }
+
+        l_workers.Run(l_concurrent, l_action_values, timestamp);
+
+        // Engines store the outputs of the actions they complete.
+        l_actions_store.RunEngines(l_action_values, l_values_store, timestamp);
+
+        for(const size_type action_idx : l_level)
+        {
+          for(const size_type downstream_idx : l_actions_store.Downstream(action_idx))
+          {
+            l_triggered.Set(downstream_idx);
+          }
+        }
       }
 
       m_queue_out.QSwapIn(l_action_values);
-    }
 
-    if(0 == --spin)
+      if constexpr(g_count_allocations)
+      {
+        if(const size_type batch_allocations = allocation_count() + l_workers.Allocations() - allocations;
+           (batch_count >= allocation_warm_up) && (0 != batch_allocations))
+        {
+          spdlog::error("Actions batch [{}] made [{}] allocations."sv, batch_count, batch_allocations);
+          m_allocating_batches.fetch_add(1, std::memory_order_relaxed);
+        }
+        ++batch_count;
+        m_batches.store(batch_count, std::memory_order_relaxed);
+      }
+    }
+    else if(0 == --spin)
     {
       spin = spin_max; // Reset spin count.
-      m_queue_in.QWait(p_stop_token, [this] { return !m_queue_in.QEmpty();});
+      m_doorbell->Wait(p_stop_token, [this] {
+        return !m_queue_in.QEmpty() || !m_timers_in.QEmpty();
+      });
     }
   }
 }
@@ -26,12 +26,15 @@
 
 #pragma once
 
+#include <atomic>
 #include <memory>
 #include <stop_token>
 
+#include "action_timer_queue.hpp"
 #include "actions_handler_fwd.hpp"
 #include "actions_result_queue.hpp"
 #include "actions_store.hpp"
+#include "queue_doorbell.hpp"
 #include "values_metric_data_queue.hpp"
 #include "values_store.hpp"
 
@@ -40,17 +43,42 @@ namespace yafiyogi::mendel {
 class ActionsHandler
 {
   public:
+    // Batches before the action path is expected to stop allocating.
+    static constexpr size_type allocation_warm_up = 100;
+
     ActionsHandler(actions::StorePtr m_actions_store,
                    values::StorePtr p_values_store,
                    values::MetricDataQueueReader && p_queue_in,
-                   actions::ActionResultQueueWriter && p_queue_out);
+                   actions::ActionTimerQueueReader && p_timers_in,
+                   QueueDoorbellPtr p_doorbell,
+                   actions::ActionResultQueueWriter && p_queue_out,
+                   size_type p_worker_count = 1);
     void Run(std::stop_token p_stop_token);
 
+    // Batches run & batches that allocated after warm up. Only counted
+    // with MENDEL_COUNT_ALLOCATIONS (see allocation_counter.hpp).
+    [[nodiscard]]
+    size_type Batches() const noexcept
+    {
+      return m_batches.load(std::memory_order_relaxed);
+    }
+
+    [[nodiscard]]
+    size_type AllocatingBatches() const noexcept
+    {
+      return m_allocating_batches.load(std::memory_order_relaxed);
+    }
+
   private:
     actions::StorePtr m_actions_store{};
     values::StorePtr m_values_store{};
     values::MetricDataQueueReader m_queue_in{};
+    actions::ActionTimerQueueReader m_timers_in{};
+    QueueDoorbellPtr m_doorbell{};
     actions::ActionResultQueueWriter m_queue_out{};
+    size_type m_worker_count = 1;
+    std::atomic<size_type> m_batches{0};
+    std::atomic<size_type> m_allocating_batches{0};
 };
 
 using ActionsHandlerPtr = std::shared_ptr<ActionsHandler>;
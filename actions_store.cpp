@@ -24,49 +24,282 @@
 
 */
 
-#include "spdlog/spdlog.h"
+#include <algorithm>
+#include <string_view>
+#include <vector>
 
-#include "yy_cpp/yy_constants.hpp"
-#include "yy_cpp/yy_find_iter_util.hpp"
+#include "spdlog/spdlog.h"
 
 #include "actions_store.hpp"
 
 namespace yafiyogi::actions {
 
+using namespace std::string_view_literals;
+
 Store::Store(store_type && p_store,
-             actions_type && p_actions):
+             actions_type && p_actions,
+             param_counts_type && p_param_counts,
+             downstream_type && p_downstream,
+             level_ends_type && p_level_ends,
+             schedules_type && p_schedules,
+             engines_type && p_engines):
   m_store(std::move(p_store)),
-  m_actions(std::move(p_actions))
+  m_actions(std::move(p_actions)),
+  m_param_counts(std::move(p_param_counts)),
+  m_downstream(std::move(p_downstream)),
+  m_level_ends(std::move(p_level_ends)),
+  m_schedules(std::move(p_schedules)),
+  m_last_run(std::make_unique<std::atomic<timestamp_type::rep>[]>(m_actions.size())),
+  m_engines(std::move(p_engines))
 {
 }
 
-void StoreBuilder::Add(ActionPtr p_action,
-                       Inputs & p_inputs)
+void Store::Resolve(values::Store & p_values_store) noexcept
+{
+  for(auto & action : m_actions)
+  {
+    action->Resolve(p_values_store);
+  }
+}
+
+void Store::RunEngines(ActionResultVector & p_results,
+                       values::Store & p_values_store,
+                       timestamp_type p_timestamp) noexcept
 {
-  auto [iter, found] = yy_data::find_iter(m_actions, p_action);
-  if(!found)
+  for(auto & engine : m_engines)
   {
-    iter = m_actions.emplace(iter, std::move(p_action)).iter;
+    engine->Run(p_results, p_values_store, p_timestamp);
   }
+}
+
+void StoreBuilder::Add(ActionPtr p_action,
+                       Inputs & p_inputs,
+                       const Outputs & p_outputs,
+                       const ActionSchedule & p_schedule)
+{
+  // Each distinct input is a param.
+  Inputs param_ids{};
+  param_ids.reserve(p_inputs.size());
 
-  Action * l_action = iter->get();
   for(auto & input_id : p_inputs)
   {
-    if(auto [pointers, p_found] = m_store_builder.add(input_id, action_pointers{});
-       nullptr != pointers)
+    if(param_ids.end() == std::find(param_ids.begin(), param_ids.end(), input_id))
     {
-      if(auto [action_pos, action_found] = yy_data::find_iter(*pointers, l_action);
-         !action_found)
-      {
-        pointers->emplace(action_pos, l_action);
-      }
+      param_ids.emplace_back(input_id);
+    }
+  }
+
+  Outputs output_ids{};
+  output_ids.reserve(p_outputs.size());
+
+  for(auto & output_id : p_outputs)
+  {
+    if(output_ids.end() == std::find(output_ids.begin(), output_ids.end(), output_id))
+    {
+      output_ids.emplace_back(output_id);
     }
   }
+
+  m_actions.emplace_back(std::move(p_action));
+  m_inputs.emplace_back(std::move(param_ids));
+  m_outputs.emplace_back(std::move(output_ids));
+  m_schedules.emplace_back(p_schedule);
+}
+
+void StoreBuilder::AddEngine(EnginePtr p_engine)
+{
+  m_engines.emplace_back(std::move(p_engine));
 }
 
 StorePtr StoreBuilder::Create()
 {
-  return std::make_unique<Store>(m_store_builder.create_automaton(), std::move(m_actions));
+  const size_type action_count = m_actions.size();
+
+  // An action reading another action's output is chained after it.
+  struct Chain final
+  {
+      size_type from = 0;
+      size_type to = 0;
+      size_type param = 0;
+  };
+
+  std::vector<Chain> chains{};
+  std::vector<std::vector<size_type>> edges(action_count);
+  std::vector<size_type> in_degree(action_count, 0);
+
+  for(size_type to = 0; to < action_count; ++to)
+  {
+    const auto & param_ids = m_inputs[to];
+
+    for(size_type param_idx = 0; param_idx < param_ids.size(); ++param_idx)
+    {
+      for(size_type from = 0; from < action_count; ++from)
+      {
+        const auto & output_ids = m_outputs[from];
+
+        if(output_ids.end() == std::find(output_ids.begin(), output_ids.end(), param_ids[param_idx]))
+        {
+          continue;
+        }
+
+        if(from == to)
+        {
+          spdlog::error("  action [{}] reads its own output [{}]. Not chained."sv,
+                        m_actions[to]->Id(),
+                        param_ids[param_idx]);
+          continue;
+        }
+
+        chains.emplace_back(Chain{from, to, param_idx});
+
+        if(auto & to_edges = edges[from];
+           to_edges.end() == std::find(to_edges.begin(), to_edges.end(), to))
+        {
+          to_edges.emplace_back(to);
+          ++in_degree[to];
+        }
+      }
+    }
+  }
+
+  // Kahn's algorithm, a level at a time. The actions of a level only
+  // depend on actions in earlier levels. Configured order is kept
+  // within a level.
+  std::vector<size_type> order{};
+  order.reserve(action_count);
+  std::vector<bool> sorted(action_count, false);
+  Store::level_ends_type level_ends{};
+  std::vector<size_type> level{};
+
+  for(size_type action_idx = 0; action_idx < action_count; ++action_idx)
+  {
+    if(0 == in_degree[action_idx])
+    {
+      level.emplace_back(action_idx);
+    }
+  }
+
+  while(!level.empty())
+  {
+    std::vector<size_type> next_level{};
+
+    for(const size_type from : level)
+    {
+      order.emplace_back(from);
+      sorted[from] = true;
+
+      for(const size_type to : edges[from])
+      {
+        if(0 == --in_degree[to])
+        {
+          next_level.emplace_back(to);
+        }
+      }
+    }
+
+    level_ends.emplace_back(order.size());
+    std::sort(next_level.begin(), next_level.end());
+    level = std::move(next_level);
+  }
+
+  // Actions in, or after, a cycle are run last & the actions of the
+  // cycle don't trigger each other.
+  if(order.size() < action_count)
+  {
+    for(size_type action_idx = 0; action_idx < action_count; ++action_idx)
+    {
+      if(!sorted[action_idx])
+      {
+        spdlog::error("  action [{}] is in, or after, a cycle of chained actions. Not chained."sv,
+                      m_actions[action_idx]->Id());
+        order.emplace_back(action_idx);
+      }
+    }
+
+    level_ends.emplace_back(order.size());
+  }
+
+  std::vector<size_type> dense_idx(action_count, 0);
+  for(size_type idx = 0; idx < action_count; ++idx)
+  {
+    dense_idx[order[idx]] = idx;
+  }
+
+  // Actions are indexed by topological order. The trie maps each input
+  // id to the actions & params it feeds.
+  store_builder_type store_builder{};
+  actions_type actions{};
+  actions.reserve(action_count);
+  Store::param_counts_type param_counts{};
+  param_counts.reserve(action_count);
+  Store::downstream_type downstream{};
+  downstream.reserve(action_count);
+  Store::schedules_type schedules{};
+  schedules.reserve(action_count);
+
+  for(size_type action_idx = 0; action_idx < action_count; ++action_idx)
+  {
+    const size_type from = order[action_idx];
+    const auto & param_ids = m_inputs[from];
+
+    for(size_type param_idx = 0; param_idx < param_ids.size(); ++param_idx)
+    {
+      if(auto [params, found] = store_builder.add(param_ids[param_idx], action_params{});
+         nullptr != params)
+      {
+        params->emplace_back(ActionParam{action_idx, param_idx});
+      }
+    }
+
+    m_actions[from]->BindParams(param_ids);
+    param_counts.emplace_back(param_ids.size());
+    schedules.emplace_back(m_schedules[from]);
+
+    std::vector<size_type> to_actions{};
+    if(sorted[from])
+    {
+      for(const size_type to : edges[from])
+      {
+        to_actions.emplace_back(dense_idx[to]);
+      }
+      std::sort(to_actions.begin(), to_actions.end());
+    }
+
+    yy_quad::simple_vector<size_type> action_downstream{};
+    action_downstream.reserve(to_actions.size());
+    for(const size_type to : to_actions)
+    {
+      action_downstream.emplace_back(to);
+    }
+    downstream.emplace_back(std::move(action_downstream));
+  }
+
+  for(const auto & chain : chains)
+  {
+    if(sorted[chain.from])
+    {
+      spdlog::info("  action [{}] input [{}] chained to action [{}]"sv,
+                   m_actions[chain.to]->Id(),
+                   m_inputs[chain.to][chain.param],
+                   m_actions[chain.from]->Id());
+      m_actions[chain.to]->BindChained(chain.param);
+    }
+  }
+
+  for(const size_type from : order)
+  {
+    actions.emplace_back(std::move(m_actions[from]));
+  }
+
+  spdlog::debug("  actions store: [{}] actions [{}] levels"sv, actions.size(), level_ends.size());
+
+  return std::make_unique<Store>(store_builder.create_automaton(),
+                                 std::move(actions),
+                                 std::move(param_counts),
+                                 std::move(downstream),
+                                 std::move(level_ends),
+                                 std::move(schedules),
+                                 std::move(m_engines));
 }
 
 } // namespace yafiyogi::actions
@@ -26,21 +26,64 @@
 
 #pragma once
 
+#include <atomic>
+#include <memory>
+#include <string>
+
+#include "yy_cpp/yy_types.hpp"
+#include "yy_cpp/yy_vector.h"
+
 #include "action.hpp"
+#include "action_engine.hpp"
 #include "values_metric_id_trie.hpp"
 
 namespace yafiyogi::actions {
 
+// An action input: the action's dense index & the input's index in the
+// action's params.
+struct ActionParam final
+{
+    size_type action = 0;
+    size_type param = 0;
+};
+
+// When an action runs without a new value. A zero period or idle
+// timeout is off.
+struct ActionSchedule final
+{
+    // Run every period.
+    timestamp_type period{};
+    // Run when the action hasn't run for the idle timeout.
+    timestamp_type idle{};
+
+    [[nodiscard]]
+    constexpr bool empty() const noexcept
+    {
+      return (timestamp_type{} == period) && (timestamp_type{} == idle);
+    }
+};
+
 class Store
 {
   public:
-    using value_type = yy_quad::simple_vector<ActionObsPtr>;
+    using value_type = yy_quad::simple_vector<ActionParam>;
     using value_ptr = std::add_pointer_t<value_type>;
     using store_builder_type = values::metric_id_trie<value_type>;
     using store_type = store_builder_type::automaton_type;
     using actions_type = yy_quad::simple_vector<actions::ActionPtr>;
-
-    Store(store_type && p_store, actions_type && p_actions);
+    using engines_type = yy_quad::simple_vector<actions::EnginePtr>;
+    using param_counts_type = yy_quad::simple_vector<size_type>;
+    using downstream_type = yy_quad::simple_vector<yy_quad::simple_vector<size_type>>;
+    using level_ends_type = yy_quad::simple_vector<size_type>;
+    using schedules_type = yy_quad::simple_vector<ActionSchedule>;
+
+    Store(store_type && p_store,
+          actions_type && p_actions,
+          param_counts_type && p_param_counts,
+          downstream_type && p_downstream,
+          level_ends_type && p_level_ends,
+          schedules_type && p_schedules,
+          engines_type && p_engines);
 
     constexpr Store() noexcept = default;
     Store(const Store &) = delete;
@@ -65,9 +108,78 @@ class Store
       return m_store.find(std::forward<Visitor>(p_visitor), p_metric);
     }
 
+    [[nodiscard]]
+    constexpr size_type ActionCount() const noexcept
+    {
+      return m_actions.size();
+    }
+
+    [[nodiscard]]
+    Action & GetAction(size_type p_action) noexcept
+    {
+      return *m_actions[p_action];
+    }
+
+    // Number of params (distinct inputs) of an action.
+    [[nodiscard]]
+    size_type ParamCount(size_type p_action) const noexcept
+    {
+      return m_param_counts[p_action];
+    }
+
+    // The actions reading the outputs of an action. They always have a
+    // higher index.
+    [[nodiscard]]
+    const yy_quad::simple_vector<size_type> & Downstream(size_type p_action) const noexcept
+    {
+      return m_downstream[p_action];
+    }
+
+    // Actions are in topological order, grouped in to levels. Actions in
+    // a level don't read each other's outputs. Each entry is one past
+    // the last action of a level.
+    [[nodiscard]]
+    constexpr const level_ends_type & LevelEnds() const noexcept
+    {
+      return m_level_ends;
+    }
+
+    [[nodiscard]]
+    const ActionSchedule & Schedule(size_type p_action) const noexcept
+    {
+      return m_schedules[p_action];
+    }
+
+    // Record when an action ran. Read by the scheduler thread.
+    void Ran(size_type p_action,
+             timestamp_type p_timestamp) noexcept
+    {
+      m_last_run[p_action].store(p_timestamp.count(), std::memory_order_relaxed);
+    }
+
+    [[nodiscard]]
+    timestamp_type LastRun(size_type p_action) const noexcept
+    {
+      return timestamp_type{m_last_run[p_action].load(std::memory_order_relaxed)};
+    }
+
+    // Resolve the value ids of every action.
+    void Resolve(values::Store & p_values_store) noexcept;
+
+    // Run the engines, after the actions of a batch.
+    void RunEngines(ActionResultVector & p_results,
+                    values::Store & p_values_store,
+                    timestamp_type p_timestamp) noexcept;
+
   private:
     store_type m_store{};
     actions_type m_actions{};
+    param_counts_type m_param_counts{};
+    downstream_type m_downstream{};
+    level_ends_type m_level_ends{};
+    schedules_type m_schedules{};
+    std::unique_ptr<std::atomic<timestamp_type::rep>[]> m_last_run{};
+    engines_type m_engines{};
 };
 
 using StorePtr = std::unique_ptr<Store>;
@@ -77,18 +189,29 @@ class StoreBuilder
   public:
     using store_builder_type = Store::store_builder_type;
     using store_type = Store::store_type;
-    using action_pointers = Store::value_type;
+    using action_params = Store::value_type;
     using actions_type = Store::actions_type;
+    using engines_type = Store::engines_type;
     using Inputs = yy_quad::simple_vector<std::string>;
+    using Outputs = yy_quad::simple_vector<std::string>;
 
-    void Add(ActionPtr action, Inputs & inputs);
+    void Add(ActionPtr action,
+             Inputs & inputs,
+             const Outputs & outputs,
+             const ActionSchedule & schedule = ActionSchedule{});
+    void AddEngine(EnginePtr p_engine);
     StorePtr Create();
 
   private:
-    using actions = yy_quad::simple_vector<ActionPtr>;
+    using inputs_type = yy_quad::simple_vector<Inputs>;
+    using outputs_type = yy_quad::simple_vector<Outputs>;
+    using schedules_type = Store::schedules_type;
 
-    store_builder_type m_store_builder{};
     actions_type m_actions{};
+    inputs_type m_inputs{};
+    outputs_type m_outputs{};
+    schedules_type m_schedules{};
+    engines_type m_engines{};
 };
 
 
@@ -0,0 +1,175 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+// Only built when MENDEL_COUNT_ALLOCATIONS is on (see CMakeLists.txt).
+
+#include <cstdlib>
+#include <new>
+
+#include "allocation_counter.hpp"
+
+namespace yafiyogi::mendel {
+namespace {
+
+thread_local size_type g_allocations = 0;
+
+void * allocate(std::size_t p_size)
+{
+  ++g_allocations;
+
+  if(void * ptr = std::malloc(0 == p_size ? 1 : p_size);
+     nullptr != ptr)
+  {
+    return ptr;
+  }
+
+  throw std::bad_alloc{};
+}
+
+void * allocate(std::size_t p_size,
+                std::align_val_t p_align)
+{
+  ++g_allocations;
+
+  const auto align = static_cast<std::size_t>(p_align);
+  // aligned_alloc() needs a size that is a multiple of the alignment.
+  const std::size_t size = ((0 == p_size ? 1 : p_size) + align - 1) / align * align;
+
+  if(void * ptr = std::aligned_alloc(align, size);
+     nullptr != ptr)
+  {
+    return ptr;
+  }
+
+  throw std::bad_alloc{};
+}
+
+} // anonymous namespace
+
+size_type allocation_count() noexcept
+{
+  return g_allocations;
+}
+
+} // namespace yafiyogi::mendel
+
+using yafiyogi::mendel::allocate;
+
+void * operator new(std::size_t p_size)
+{
+  return allocate(p_size);
+}
+
+void * operator new[](std::size_t p_size)
+{
+  return allocate(p_size);
+}
+
+void * operator new(std::size_t p_size,
+                    std::align_val_t p_align)
+{
+  return allocate(p_size, p_align);
+}
+
+void * operator new[](std::size_t p_size,
+                      std::align_val_t p_align)
+{
+  return allocate(p_size, p_align);
+}
+
+void * operator new(std::size_t p_size,
+                    const std::nothrow_t &) noexcept
+{
+  try
+  {
+    return allocate(p_size);
+  }
+  catch(...)
+  {
+    return nullptr;
+  }
+}
+
+void * operator new[](std::size_t p_size,
+                      const std::nothrow_t &) noexcept
+{
+  try
+  {
+    return allocate(p_size);
+  }
+  catch(...)
+  {
+    return nullptr;
+  }
+}
+
+void operator delete(void * p_ptr) noexcept
+{
+  std::free(p_ptr);
+}
+
+void operator delete[](void * p_ptr) noexcept
+{
+  std::free(p_ptr);
+}
+
+void operator delete(void * p_ptr,
+                     std::size_t /* p_size */) noexcept
+{
+  std::free(p_ptr);
+}
+
+void operator delete[](void * p_ptr,
+                       std::size_t /* p_size */) noexcept
+{
+  std::free(p_ptr);
+}
+
+void operator delete(void * p_ptr,
+                     std::align_val_t /* p_align */) noexcept
+{
+  std::free(p_ptr);
+}
+
+void operator delete[](void * p_ptr,
+                       std::align_val_t /* p_align */) noexcept
+{
+  std::free(p_ptr);
+}
+
+void operator delete(void * p_ptr,
+                     std::size_t /* p_size */,
+                     std::align_val_t /* p_align */) noexcept
+{
+  std::free(p_ptr);
+}
+
+void operator delete[](void * p_ptr,
+                       std::size_t /* p_size */,
+                       std::align_val_t /* p_align */) noexcept
+{
+  std::free(p_ptr);
+}
@@ -0,0 +1,52 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include "yy_cpp/yy_types.hpp"
+
+namespace yafiyogi::mendel {
+
+// Configure with -DMENDEL_COUNT_ALLOCATIONS=ON to replace the global
+// operator new & count the heap allocations made by each thread.
+// ActionWorkers::Allocations() totals the counts of its worker threads.
+#if defined(MENDEL_COUNT_ALLOCATIONS)
+inline constexpr bool g_count_allocations = true;
+
+// Allocations made by the calling thread.
+[[nodiscard]]
+size_type allocation_count() noexcept;
+#else
+inline constexpr bool g_count_allocations = false;
+
+[[nodiscard]]
+constexpr size_type allocation_count() noexcept
+{
+  return 0;
+}
+#endif
+
+} // namespace yafiyogi::mendel
@@ -0,0 +1,171 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+// Benchmark of Kalman actions of one shape run through KalmanBatches
+// versus a KalmanFixed kernel per action. Both are fed the same
+// observations & the states are checked to match.
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <string_view>
+#include <vector>
+
+#include "spdlog/spdlog.h"
+
+#include "kalman_batch.hpp"
+#include "kalman_fixed.hpp"
+
+namespace yafiyogi {
+namespace {
+
+using namespace std::string_view_literals;
+using actions::KalmanModel;
+
+constexpr size_type g_filters = 1024;
+constexpr size_type g_rounds = 10'000;
+constexpr size_type g_states = 2;
+constexpr size_type g_inputs = 3;
+constexpr KalmanModel g_model = KalmanModel::ConstantVelocity;
+constexpr double g_process_noise = 0.01;
+constexpr double g_tolerance = 1e-9;
+
+constexpr size_type g_input_states[g_inputs]{0, 0, 0};
+constexpr double g_r[g_inputs]{0.5, 1.0, 2.0};
+
+// Not every input is observed every round.
+constexpr bool observed(size_type p_round,
+                        size_type p_filter,
+                        size_type p_input) noexcept
+{
+  return 0 != ((p_round + p_filter + p_input) % 3);
+}
+
+double observation(size_type p_round,
+                   size_type p_filter,
+                   size_type p_input) noexcept
+{
+  return std::sin(static_cast<double>(p_round) * 0.01 + static_cast<double>(p_filter))
+    + static_cast<double>(p_input) * 0.1;
+}
+
+using clock_type = std::chrono::steady_clock;
+using duration_type = std::chrono::duration<double, std::nano>;
+
+} // anonymous namespace
+} // namespace yafiyogi
+
+int main()
+{
+  using namespace yafiyogi;
+  using namespace std::string_view_literals;
+
+  std::vector<actions::KalmanKernelPtr> kernels{};
+  actions::KalmanBatches batches{};
+  std::vector<actions::KalmanBatches::Lane> lanes{};
+
+  for(size_type filter = 0; filter < g_filters; ++filter)
+  {
+    kernels.emplace_back(actions::make_kalman_fixed(g_states, g_inputs, g_input_states, g_r, g_process_noise, g_model));
+    lanes.emplace_back(batches.Add(g_states, g_inputs, g_input_states, g_r, g_process_noise, g_model));
+
+    if(!kernels.back() || !lanes.back().batch)
+    {
+      spdlog::error("No kalman kernel for [{}x{}]"sv, g_states, g_inputs);
+      return 1;
+    }
+  }
+
+  // Every lane is in the same batch.
+  auto batch = lanes.front().batch;
+
+  duration_type fixed_time{};
+  duration_type batch_time{};
+
+  for(size_type round = 0; round < g_rounds; ++round)
+  {
+    auto begin = clock_type::now();
+    for(size_type filter = 0; filter < g_filters; ++filter)
+    {
+      auto & kernel = *kernels[filter];
+
+      for(size_type input = 0; input < g_inputs; ++input)
+      {
+        if(observed(round, filter, input))
+        {
+          kernel.Observe(input, observation(round, filter, input));
+        }
+      }
+      kernel.Step(1.0);
+    }
+    fixed_time += clock_type::now() - begin;
+
+    begin = clock_type::now();
+    for(size_type filter = 0; filter < g_filters; ++filter)
+    {
+      const auto lane = lanes[filter].lane;
+
+      for(size_type input = 0; input < g_inputs; ++input)
+      {
+        if(observed(round, filter, input))
+        {
+          batch->Observe(lane, input, observation(round, filter, input));
+        }
+      }
+      batch->Trigger(lane, 1.0);
+    }
+    batch->Step();
+    batch_time += clock_type::now() - begin;
+  }
+
+  double max_error = 0.0;
+  for(size_type filter = 0; filter < g_filters; ++filter)
+  {
+    for(size_type state = 0; state < g_states; ++state)
+    {
+      const double fixed_x = kernels[filter]->X(state);
+      const double batch_x = batch->X(lanes[filter].lane, state);
+
+      max_error = std::max(max_error, std::abs(fixed_x - batch_x) / std::max(1.0, std::abs(fixed_x)));
+    }
+  }
+
+  const double steps = static_cast<double>(g_filters * g_rounds);
+
+  spdlog::info("Kalman [{}x{}]: [{}] filters x [{}] rounds"sv, g_states, g_inputs, g_filters, g_rounds);
+  spdlog::info(" fixed   : [{:.2f}] ns/step"sv, fixed_time.count() / steps);
+  spdlog::info(" batched : [{:.2f}] ns/step"sv, batch_time.count() / steps);
+  spdlog::info(" speed up: [{:.2f}]x"sv, fixed_time.count() / batch_time.count());
+  spdlog::info(" max relative difference [{:.3g}]"sv, max_error);
+
+  if(!(max_error <= g_tolerance))
+  {
+    spdlog::error("Batched states differ from the fixed kernels"sv);
+    return 1;
+  }
+
+  return 0;
+}
@@ -0,0 +1,120 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+// Benchmark of the cache & actions threads each writing their own value.
+// 'one block' has both values on one cache line, as before values were
+// grouped by writer. 'grouped' is the layout StoreBuilder now creates,
+// the actions value in its own block.
+
+#include <atomic>
+#include <chrono>
+#include <string_view>
+#include <tuple>
+#include <thread>
+
+#include "spdlog/spdlog.h"
+
+#include "values_store.hpp"
+
+namespace yafiyogi {
+namespace {
+
+using namespace std::string_view_literals;
+
+constexpr size_type g_writes = 20'000'000;
+constexpr std::string_view g_cache_id{"Bench:Cache"};
+constexpr std::string_view g_actions_id{"Bench:Actions"};
+
+values::StorePtr make_store(values::Writer p_actions_writer)
+{
+  values::StoreBuilder builder{};
+
+  builder.Add(std::string{g_cache_id}, values::Writer::Cache);
+  builder.Add(std::string{g_actions_id}, p_actions_writer);
+
+  return builder.Create();
+}
+
+// Two threads writing a slot each. Returns ns per write.
+double run(values::Store & p_store)
+{
+  const auto cache_slot = p_store.Resolve(g_cache_id);
+  const auto actions_slot = p_store.Resolve(g_actions_id);
+  std::atomic<bool> start{false};
+
+  auto writer = [&p_store, &start](values::Store::slot_type p_slot) {
+    while(!start.load(std::memory_order_acquire))
+    {
+    }
+
+    auto & value = p_store.Value(p_slot);
+    for(size_type idx = 0; idx < g_writes; ++idx)
+    {
+      std::ignore = value.Store(static_cast<double>(idx),
+                                timestamp_type{static_cast<timestamp_type::rep>(idx)},
+                                values::Quality::Measured);
+    }
+  };
+
+  const auto begin = std::chrono::steady_clock::now();
+  {
+    std::jthread cache_thread{writer, cache_slot};
+    std::jthread actions_thread{writer, actions_slot};
+
+    start.store(true, std::memory_order_release);
+  }
+  const std::chrono::duration<double, std::nano> elapsed{std::chrono::steady_clock::now() - begin};
+
+  spdlog::info("  slots [{}] & [{}], same block [{}]"sv,
+               cache_slot,
+               actions_slot,
+               (cache_slot / values::Store::values_per_block) == (actions_slot / values::Store::values_per_block));
+
+  return elapsed.count() / static_cast<double>(g_writes);
+}
+
+} // anonymous namespace
+} // namespace yafiyogi
+
+int main()
+{
+  using namespace yafiyogi;
+  using namespace std::string_view_literals;
+
+  spdlog::info("Values store: 2 threads x [{}] writes"sv, g_writes);
+
+  auto one_block{make_store(values::Writer::Cache)};
+  const double one_block_ns = run(*one_block);
+  spdlog::info(" one block: [{:.2f}] ns/write"sv, one_block_ns);
+
+  auto grouped{make_store(values::Writer::Actions)};
+  const double grouped_ns = run(*grouped);
+  spdlog::info(" grouped  : [{:.2f}] ns/write"sv, grouped_ns);
+
+  spdlog::info(" speed up : [{:.2f}]x"sv, one_block_ns / grouped_ns);
+
+  return 0;
+}
@@ -0,0 +1,891 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <tuple>
+#include <type_traits>
+
+#include "boost/json/error.hpp"
+
+#include "yy_cpp/yy_types.hpp"
+
+namespace yafiyogi::mendel {
+namespace binary_json_detail {
+
+// Reads big endian values from a payload.
+class Cursor final
+{
+  public:
+    constexpr explicit Cursor(std::string_view p_data) noexcept:
+      m_data(p_data)
+    {
+    }
+
+    [[nodiscard]]
+    constexpr bool peek(std::uint8_t & p_byte) const noexcept
+    {
+      if(m_data.empty())
+      {
+        return false;
+      }
+
+      p_byte = static_cast<std::uint8_t>(m_data.front());
+      return true;
+    }
+
+    template<typename T>
+    [[nodiscard]]
+    bool read(T & p_value) noexcept
+    {
+      if(m_data.size() < sizeof(T))
+      {
+        return false;
+      }
+
+      std::array<char, sizeof(T)> bytes;
+      std::memcpy(bytes.data(), m_data.data(), sizeof(T));
+
+      if constexpr(std::endian::big != std::endian::native)
+      {
+        std::reverse(bytes.begin(), bytes.end());
+      }
+
+      p_value = std::bit_cast<T>(bytes);
+      m_data.remove_prefix(sizeof(T));
+
+      return true;
+    }
+
+    [[nodiscard]]
+    bool read(std::uint64_t p_size,
+              std::string_view & p_bytes) noexcept
+    {
+      if(m_data.size() < p_size)
+      {
+        return false;
+      }
+
+      p_bytes = m_data.substr(0, static_cast<size_type>(p_size));
+      m_data.remove_prefix(static_cast<size_type>(p_size));
+
+      return true;
+    }
+
+  private:
+    std::string_view m_data{};
+};
+
+// Json handlers take the text of numbers as well as the value.
+class NumberText final
+{
+  public:
+    template<typename T>
+    std::string_view format(T p_value) noexcept
+    {
+      char * begin = m_buffer.data();
+
+      if(const auto [ptr, ec] = std::to_chars(begin, begin + m_buffer.size(), p_value);
+         std::errc{} == ec)
+      {
+        return std::string_view{begin, ptr};
+      }
+
+      return std::string_view{};
+    }
+
+  private:
+    std::array<char, 64> m_buffer{};
+};
+
+inline double half_to_double(std::uint16_t p_half) noexcept
+{
+  const int exponent = (p_half >> 10) & 0x1f;
+  const int mantissa = p_half & 0x3ff;
+  double value = 0.0;
+
+  if(0 == exponent)
+  {
+    value = std::ldexp(mantissa, -24);
+  }
+  else if(0x1f == exponent)
+  {
+    value = (0 == mantissa) ? std::numeric_limits<double>::infinity() : std::numeric_limits<double>::quiet_NaN();
+  }
+  else
+  {
+    value = std::ldexp(mantissa + 0x400, exponent - 25);
+  }
+
+  return (0 != (p_half & 0x8000)) ? -value : value;
+}
+
+} // namespace binary_json_detail
+
+// Walks a CBOR (RFC 8949) payload calling a boost::json basic_parser
+// style handler, so json pointer handlers work unchanged. Byte strings,
+// undefined & simple values are reported as null. Stops once the
+// handler's visitor has seen all its pointers.
+template<typename HandlerType>
+class CborReader final
+{
+  public:
+    using handler_type = HandlerType;
+
+    constexpr explicit CborReader(size_type p_max_depth) noexcept:
+      m_max_depth(p_max_depth)
+    {
+    }
+
+    CborReader() = delete;
+    CborReader(const CborReader &) = default;
+    CborReader(CborReader &&) noexcept = default;
+
+    CborReader & operator=(const CborReader &) = default;
+    CborReader & operator=(CborReader &&) noexcept = default;
+
+    bool read(std::string_view p_data,
+              handler_type & p_handler) noexcept
+    {
+      binary_json_detail::Cursor cursor{p_data};
+      boost::json::error_code ec{};
+
+      return p_handler.on_document_begin(ec)
+        && item(cursor, p_handler, 0, ec)
+        && p_handler.on_document_end(ec);
+    }
+
+  private:
+    static constexpr std::uint8_t g_break = 0xff;
+
+    enum item_types:std::uint8_t {Unsigned = 0, Negative, Bytes, Text, Array, Map, Tag, Simple};
+
+    [[nodiscard]]
+    static bool done(handler_type & p_handler) noexcept
+    {
+      return p_handler.visitor().all_pointers_seen();
+    }
+
+    [[nodiscard]]
+    static bool argument(binary_json_detail::Cursor & p_cursor,
+                         std::uint8_t p_info,
+                         std::uint64_t & p_arg) noexcept
+    {
+      switch(p_info)
+      {
+        case 24:
+        {
+          std::uint8_t arg = 0;
+          const bool ok = p_cursor.read(arg);
+          p_arg = arg;
+          return ok;
+        }
+
+        case 25:
+        {
+          std::uint16_t arg = 0;
+          const bool ok = p_cursor.read(arg);
+          p_arg = arg;
+          return ok;
+        }
+
+        case 26:
+        {
+          std::uint32_t arg = 0;
+          const bool ok = p_cursor.read(arg);
+          p_arg = arg;
+          return ok;
+        }
+
+        case 27:
+          return p_cursor.read(p_arg);
+
+        default:
+          break;
+      }
+
+      p_arg = p_info;
+
+      return p_info < 24;
+    }
+
+    // Definite length strings are returned in place; chunks of
+    // indefinite length strings are joined in 'm_text'.
+    [[nodiscard]]
+    bool string(binary_json_detail::Cursor & p_cursor,
+                std::uint8_t p_item_type,
+                bool p_indefinite,
+                std::uint64_t p_size,
+                std::string_view & p_str)
+    {
+      if(!p_indefinite)
+      {
+        return p_cursor.read(p_size, p_str);
+      }
+
+      m_text.clear();
+
+      std::uint8_t initial = 0;
+      while(p_cursor.peek(initial) && (g_break != initial))
+      {
+        std::ignore = p_cursor.read(initial);
+
+        std::uint64_t size = 0;
+        std::string_view chunk{};
+        if((p_item_type != (initial >> 5))
+           || !argument(p_cursor, initial & 0x1f, size)
+           || !p_cursor.read(size, chunk))
+        {
+          return false;
+        }
+
+        m_text.append(chunk);
+      }
+
+      p_str = m_text;
+
+      return p_cursor.read(initial); // break
+    }
+
+    [[nodiscard]]
+    bool key(binary_json_detail::Cursor & p_cursor,
+             handler_type & p_handler,
+             boost::json::error_code & p_ec)
+    {
+      std::uint8_t initial = 0;
+      if(!p_cursor.read(initial))
+      {
+        return false;
+      }
+
+      const std::uint8_t item_type = initial >> 5;
+      const std::uint8_t info = initial & 0x1f;
+      const bool indefinite = (0x1f == info);
+      std::uint64_t arg = 0;
+
+      if(!indefinite && !argument(p_cursor, info, arg))
+      {
+        return false;
+      }
+
+      std::string_view key_str{};
+      switch(item_type)
+      {
+        case item_types::Text:
+          if(!string(p_cursor, item_type, indefinite, arg, key_str))
+          {
+            return false;
+          }
+          break;
+
+        case item_types::Unsigned:
+          if(indefinite)
+          {
+            return false;
+          }
+          key_str = m_number.format(arg);
+          break;
+
+        default:
+          return false;
+      }
+
+      return p_handler.on_key(key_str, key_str.size(), p_ec);
+    }
+
+    [[nodiscard]]
+    bool simple(binary_json_detail::Cursor & p_cursor,
+                std::uint8_t p_info,
+                handler_type & p_handler,
+                boost::json::error_code & p_ec)
+    {
+      switch(p_info)
+      {
+        case 20:
+          return p_handler.on_bool(false, p_ec) && !done(p_handler);
+
+        case 21:
+          return p_handler.on_bool(true, p_ec) && !done(p_handler);
+
+        case 24:
+        {
+          std::uint8_t value = 0;
+          return p_cursor.read(value) && p_handler.on_null(p_ec);
+        }
+
+        case 25:
+        {
+          std::uint16_t half = 0;
+          if(!p_cursor.read(half))
+          {
+            return false;
+          }
+
+          const double value = binary_json_detail::half_to_double(half);
+          return p_handler.on_double(value, m_number.format(value), p_ec) && !done(p_handler);
+        }
+
+        case 26:
+        {
+          float value = 0.0f;
+          if(!p_cursor.read(value))
+          {
+            return false;
+          }
+
+          return p_handler.on_double(value, m_number.format(value), p_ec) && !done(p_handler);
+        }
+
+        case 27:
+        {
+          double value = 0.0;
+          if(!p_cursor.read(value))
+          {
+            return false;
+          }
+
+          return p_handler.on_double(value, m_number.format(value), p_ec) && !done(p_handler);
+        }
+
+        case 0x1f: // Unexpected break.
+          return false;
+
+        default:
+          break;
+      }
+
+      // null, undefined & unassigned simple values.
+      return p_handler.on_null(p_ec);
+    }
+
+    [[nodiscard]]
+    bool item(binary_json_detail::Cursor & p_cursor,
+              handler_type & p_handler,
+              size_type p_depth,
+              boost::json::error_code & p_ec)
+    {
+      std::uint8_t initial = 0;
+      if((p_depth > m_max_depth) || !p_cursor.read(initial))
+      {
+        return false;
+      }
+
+      const std::uint8_t item_type = initial >> 5;
+      const std::uint8_t info = initial & 0x1f;
+
+      if(item_types::Simple == item_type)
+      {
+        return simple(p_cursor, info, p_handler, p_ec);
+      }
+
+      const bool indefinite = (0x1f == info);
+      std::uint64_t arg = 0;
+      if(!indefinite && !argument(p_cursor, info, arg))
+      {
+        return false;
+      }
+
+      switch(item_type)
+      {
+        case item_types::Unsigned:
+          if(indefinite)
+          {
+            return false;
+          }
+
+          if(arg <= static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()))
+          {
+            return p_handler.on_int64(static_cast<std::int64_t>(arg), m_number.format(arg), p_ec) && !done(p_handler);
+          }
+          return p_handler.on_uint64(arg, m_number.format(arg), p_ec) && !done(p_handler);
+
+        case item_types::Negative:
+          if(indefinite)
+          {
+            return false;
+          }
+
+          if(arg <= static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()))
+          {
+            const std::int64_t value = -1 - static_cast<std::int64_t>(arg);
+            return p_handler.on_int64(value, m_number.format(value), p_ec) && !done(p_handler);
+          }
+          else
+          {
+            const double value = -1.0 - static_cast<double>(arg);
+            return p_handler.on_double(value, m_number.format(value), p_ec) && !done(p_handler);
+          }
+
+        case item_types::Bytes:
+        {
+          std::string_view bytes{};
+          return string(p_cursor, item_type, indefinite, arg, bytes) && p_handler.on_null(p_ec);
+        }
+
+        case item_types::Text:
+        {
+          std::string_view str{};
+          return string(p_cursor, item_type, indefinite, arg, str)
+            && p_handler.on_string(str, str.size(), p_ec)
+            && !done(p_handler);
+        }
+
+        case item_types::Array:
+        {
+          if(!p_handler.on_array_begin(p_ec))
+          {
+            return false;
+          }
+
+          std::uint64_t count = 0;
+          std::uint8_t next = 0;
+          while(indefinite ? (p_cursor.peek(next) && (g_break != next)) : (count < arg))
+          {
+            if(!item(p_cursor, p_handler, p_depth + 1, p_ec))
+            {
+              return false;
+            }
+            ++count;
+          }
+
+          if(indefinite && !p_cursor.read(next))
+          {
+            return false;
+          }
+
+          return p_handler.on_array_end(static_cast<size_type>(count), p_ec);
+        }
+
+        case item_types::Map:
+        {
+          if(!p_handler.on_object_begin(p_ec))
+          {
+            return false;
+          }
+
+          std::uint64_t count = 0;
+          std::uint8_t next = 0;
+          while(indefinite ? (p_cursor.peek(next) && (g_break != next)) : (count < arg))
+          {
+            if(!key(p_cursor, p_handler, p_ec)
+               || !item(p_cursor, p_handler, p_depth + 1, p_ec))
+            {
+              return false;
+            }
+            ++count;
+          }
+
+          if(indefinite && !p_cursor.read(next))
+          {
+            return false;
+          }
+
+          return p_handler.on_object_end(static_cast<size_type>(count), p_ec);
+        }
+
+        case item_types::Tag:
+          // Tags only annotate the following item. Each tag counts as a
+          // level so a chain of tags can't recurse past the max depth.
+          return !indefinite && item(p_cursor, p_handler, p_depth + 1, p_ec);
+
+        default:
+          break;
+      }
+
+      return false;
+    }
+
+    size_type m_max_depth = 0;
+    std::string m_text{};
+    binary_json_detail::NumberText m_number{};
+};
+
+// Walks a MessagePack payload calling a boost::json basic_parser style
+// handler, so json pointer handlers work unchanged. Binary & extension
+// values are reported as null. Stops once the handler's visitor has
+// seen all its pointers.
+template<typename HandlerType>
+class MsgpackReader final
+{
+  public:
+    using handler_type = HandlerType;
+
+    constexpr explicit MsgpackReader(size_type p_max_depth) noexcept:
+      m_max_depth(p_max_depth)
+    {
+    }
+
+    MsgpackReader() = delete;
+    MsgpackReader(const MsgpackReader &) = default;
+    MsgpackReader(MsgpackReader &&) noexcept = default;
+
+    MsgpackReader & operator=(const MsgpackReader &) = default;
+    MsgpackReader & operator=(MsgpackReader &&) noexcept = default;
+
+    bool read(std::string_view p_data,
+              handler_type & p_handler) noexcept
+    {
+      binary_json_detail::Cursor cursor{p_data};
+      boost::json::error_code ec{};
+
+      return p_handler.on_document_begin(ec)
+        && item(cursor, p_handler, 0, ec)
+        && p_handler.on_document_end(ec);
+    }
+
+  private:
+    [[nodiscard]]
+    static bool done(handler_type & p_handler) noexcept
+    {
+      return p_handler.visitor().all_pointers_seen();
+    }
+
+    template<typename SizeType>
+    [[nodiscard]]
+    static bool size(binary_json_detail::Cursor & p_cursor,
+                     std::uint64_t & p_size) noexcept
+    {
+      SizeType size = 0;
+      const bool ok = p_cursor.read(size);
+      p_size = size;
+
+      return ok;
+    }
+
+    template<typename T>
+    [[nodiscard]]
+    bool integer(binary_json_detail::Cursor & p_cursor,
+                 handler_type & p_handler,
+                 boost::json::error_code & p_ec)
+    {
+      T value = 0;
+      if(!p_cursor.read(value))
+      {
+        return false;
+      }
+
+      if constexpr(std::is_same_v<T, std::uint64_t>)
+      {
+        if(value > static_cast<std::uint64_t>(std::numeric_limits<std::int64_t>::max()))
+        {
+          return p_handler.on_uint64(value, m_number.format(value), p_ec) && !done(p_handler);
+        }
+      }
+
+      return p_handler.on_int64(static_cast<std::int64_t>(value), m_number.format(value), p_ec) && !done(p_handler);
+    }
+
+    template<typename T>
+    [[nodiscard]]
+    bool floating(binary_json_detail::Cursor & p_cursor,
+                  handler_type & p_handler,
+                  boost::json::error_code & p_ec)
+    {
+      T value = 0;
+      if(!p_cursor.read(value))
+      {
+        return false;
+      }
+
+      return p_handler.on_double(static_cast<double>(value), m_number.format(value), p_ec) && !done(p_handler);
+    }
+
+    [[nodiscard]]
+    bool skip(binary_json_detail::Cursor & p_cursor,
+              std::uint64_t p_size,
+              handler_type & p_handler,
+              boost::json::error_code & p_ec)
+    {
+      std::string_view bytes{};
+      return p_cursor.read(p_size, bytes) && p_handler.on_null(p_ec);
+    }
+
+    // Keys are usually strings, but integer keys are allowed.
+    [[nodiscard]]
+    bool key(binary_json_detail::Cursor & p_cursor,
+             handler_type & p_handler,
+             boost::json::error_code & p_ec)
+    {
+      std::uint8_t initial = 0;
+      if(!p_cursor.read(initial))
+      {
+        return false;
+      }
+
+      std::uint64_t length = 0;
+      std::string_view key_str{};
+
+      if(initial <= 0x7f)
+      {
+        key_str = m_number.format(initial);
+      }
+      else if((initial >= 0xa0) && (initial <= 0xbf))
+      {
+        length = initial & 0x1f;
+      }
+      else if(0xd9 == initial)
+      {
+        if(!size<std::uint8_t>(p_cursor, length))
+        {
+          return false;
+        }
+      }
+      else if(0xda == initial)
+      {
+        if(!size<std::uint16_t>(p_cursor, length))
+        {
+          return false;
+        }
+      }
+      else if(0xdb == initial)
+      {
+        if(!size<std::uint32_t>(p_cursor, length))
+        {
+          return false;
+        }
+      }
+      else
+      {
+        return false;
+      }
+
+      if((initial > 0x7f) && !p_cursor.read(length, key_str))
+      {
+        return false;
+      }
+
+      return p_handler.on_key(key_str, key_str.size(), p_ec);
+    }
+
+    [[nodiscard]]
+    bool array(binary_json_detail::Cursor & p_cursor,
+               std::uint64_t p_count,
+               handler_type & p_handler,
+               size_type p_depth,
+               boost::json::error_code & p_ec)
+    {
+      if(!p_handler.on_array_begin(p_ec))
+      {
+        return false;
+      }
+
+      for(std::uint64_t idx = 0; idx < p_count; ++idx)
+      {
+        if(!item(p_cursor, p_handler, p_depth + 1, p_ec))
+        {
+          return false;
+        }
+      }
+
+      return p_handler.on_array_end(static_cast<size_type>(p_count), p_ec);
+    }
+
+    [[nodiscard]]
+    bool map(binary_json_detail::Cursor & p_cursor,
+             std::uint64_t p_count,
+             handler_type & p_handler,
+             size_type p_depth,
+             boost::json::error_code & p_ec)
+    {
+      if(!p_handler.on_object_begin(p_ec))
+      {
+        return false;
+      }
+
+      for(std::uint64_t idx = 0; idx < p_count; ++idx)
+      {
+        if(!key(p_cursor, p_handler, p_ec)
+           || !item(p_cursor, p_handler, p_depth + 1, p_ec))
+        {
+          return false;
+        }
+      }
+
+      return p_handler.on_object_end(static_cast<size_type>(p_count), p_ec);
+    }
+
+    [[nodiscard]]
+    bool string(binary_json_detail::Cursor & p_cursor,
+                std::uint64_t p_length,
+                handler_type & p_handler,
+                boost::json::error_code & p_ec)
+    {
+      std::string_view str{};
+      return p_cursor.read(p_length, str)
+        && p_handler.on_string(str, str.size(), p_ec)
+        && !done(p_handler);
+    }
+
+    [[nodiscard]]
+    bool item(binary_json_detail::Cursor & p_cursor,
+              handler_type & p_handler,
+              size_type p_depth,
+              boost::json::error_code & p_ec)
+    {
+      std::uint8_t initial = 0;
+      if((p_depth > m_max_depth) || !p_cursor.read(initial))
+      {
+        return false;
+      }
+
+      if(initial <= 0x7f) // positive fixint
+      {
+        return p_handler.on_int64(initial, m_number.format(initial), p_ec) && !done(p_handler);
+      }
+
+      if(initial >= 0xe0) // negative fixint
+      {
+        const std::int64_t value = static_cast<std::int8_t>(initial);
+        return p_handler.on_int64(value, m_number.format(value), p_ec) && !done(p_handler);
+      }
+
+      if(initial <= 0x8f)
+      {
+        return map(p_cursor, initial & 0x0f, p_handler, p_depth, p_ec);
+      }
+
+      if(initial <= 0x9f)
+      {
+        return array(p_cursor, initial & 0x0f, p_handler, p_depth, p_ec);
+      }
+
+      if(initial <= 0xbf)
+      {
+        return string(p_cursor, initial & 0x1f, p_handler, p_ec);
+      }
+
+      std::uint64_t length = 0;
+      std::uint8_t ext_type = 0;
+
+      switch(initial)
+      {
+        case 0xc0:
+          return p_handler.on_null(p_ec);
+
+        case 0xc2:
+          return p_handler.on_bool(false, p_ec) && !done(p_handler);
+
+        case 0xc3:
+          return p_handler.on_bool(true, p_ec) && !done(p_handler);
+
+        case 0xc4: // bin 8
+          return size<std::uint8_t>(p_cursor, length) && skip(p_cursor, length, p_handler, p_ec);
+
+        case 0xc5: // bin 16
+          return size<std::uint16_t>(p_cursor, length) && skip(p_cursor, length, p_handler, p_ec);
+
+        case 0xc6: // bin 32
+          return size<std::uint32_t>(p_cursor, length) && skip(p_cursor, length, p_handler, p_ec);
+
+        case 0xc7: // ext 8
+          return size<std::uint8_t>(p_cursor, length) && p_cursor.read(ext_type) && skip(p_cursor, length, p_handler, p_ec);
+
+        case 0xc8: // ext 16
+          return size<std::uint16_t>(p_cursor, length) && p_cursor.read(ext_type) && skip(p_cursor, length, p_handler, p_ec);
+
+        case 0xc9: // ext 32
+          return size<std::uint32_t>(p_cursor, length) && p_cursor.read(ext_type) && skip(p_cursor, length, p_handler, p_ec);
+
+        case 0xca:
+          return floating<float>(p_cursor, p_handler, p_ec);
+
+        case 0xcb:
+          return floating<double>(p_cursor, p_handler, p_ec);
+
+        case 0xcc:
+          return integer<std::uint8_t>(p_cursor, p_handler, p_ec);
+
+        case 0xcd:
+          return integer<std::uint16_t>(p_cursor, p_handler, p_ec);
+
+        case 0xce:
+          return integer<std::uint32_t>(p_cursor, p_handler, p_ec);
+
+        case 0xcf:
+          return integer<std::uint64_t>(p_cursor, p_handler, p_ec);
+
+        case 0xd0:
+          return integer<std::int8_t>(p_cursor, p_handler, p_ec);
+
+        case 0xd1:
+          return integer<std::int16_t>(p_cursor, p_handler, p_ec);
+
+        case 0xd2:
+          return integer<std::int32_t>(p_cursor, p_handler, p_ec);
+
+        case 0xd3:
+          return integer<std::int64_t>(p_cursor, p_handler, p_ec);
+
+        case 0xd4: // fixext 1
+        case 0xd5: // fixext 2
+        case 0xd6: // fixext 4
+        case 0xd7: // fixext 8
+        case 0xd8: // fixext 16
+          return p_cursor.read(ext_type) && skip(p_cursor, std::uint64_t{1} << (initial - 0xd4), p_handler, p_ec);
+
+        case 0xd9:
+          return size<std::uint8_t>(p_cursor, length) && string(p_cursor, length, p_handler, p_ec);
+
+        case 0xda:
+          return size<std::uint16_t>(p_cursor, length) && string(p_cursor, length, p_handler, p_ec);
+
+        case 0xdb:
+          return size<std::uint32_t>(p_cursor, length) && string(p_cursor, length, p_handler, p_ec);
+
+        case 0xdc:
+          return size<std::uint16_t>(p_cursor, length) && array(p_cursor, length, p_handler, p_depth, p_ec);
+
+        case 0xdd:
+          return size<std::uint32_t>(p_cursor, length) && array(p_cursor, length, p_handler, p_depth, p_ec);
+
+        case 0xde:
+          return size<std::uint16_t>(p_cursor, length) && map(p_cursor, length, p_handler, p_depth, p_ec);
+
+        case 0xdf:
+          return size<std::uint32_t>(p_cursor, length) && map(p_cursor, length, p_handler, p_depth, p_ec);
+
+        default: // 0xc1 is never used.
+          break;
+      }
+
+      return false;
+    }
+
+    size_type m_max_depth = 0;
+    binary_json_detail::NumberText m_number{};
+};
+
+} // namespace yafiyogi::mendel
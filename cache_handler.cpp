@@ -25,6 +25,7 @@
 */
 
 #include <charconv>
+#include <variant>
 
 #include "spdlog/spdlog.h"
 
@@ -44,10 +45,12 @@ constexpr size_type spin_max = 400;
 } // anonymous namespace
 
 CacheHandler::CacheHandler(values::StorePtr p_values_store,
-                           values::MetricDataQueueReader && p_cache_queue,
-                           values::MetricDataQueueWriter && p_action_queue):
+                           values::MetricDataLanes && p_cache_lanes,
+                           values::MetricDataLaneWriter && p_action_queue,
+                           size_type p_cache_capacity):
   m_values_store(std::move(p_values_store)),
-  m_cache_queue(std::move(p_cache_queue)),
+  m_store_cache(p_cache_capacity),
+  m_cache_lanes(std::move(p_cache_lanes)),
   m_action_queue(std::move(p_action_queue))
 {
 }
@@ -62,7 +65,7 @@ void CacheHandler::Run(std::stop_token p_stop_token)
   size_type spin = 1; // Set to 1 to prevent spinning at startup.
   while(!p_stop_token.stop_requested())
   {
-    while(m_cache_queue.QSwapOut(l_data_in))
+    while(m_cache_lanes.QSwapOut(l_data_in))
     {
       spin = spin_max; // Reset spin count.
 
@@ -73,23 +76,39 @@ void CacheHandler::Run(std::stop_token p_stop_token)
       {
         auto & metric_id = data.Id();
 
-        std::string_view value_str{data.Value()};
+        auto add_value_to_store = [&send_data, &l_data_out, &data](value_ptr p_value) {
+          double value = 0.0;
+          std::visit([&value](double p_binary) {
+            value = p_binary;
+          }, data.Binary());
 
-        auto add_value_to_store = [&send_data, &l_data_out, &data, value_str](value_ptr p_value) {
-          double value;
-          if(const auto [_, ec] = std::from_chars(value_str.begin(),
-                                                  value_str.end(),
-                                                  value);
-             std::errc{} == ec)
+          // Parsers set the binary value when they decode a number, so
+          // only parse the text when there isn't one. Zero can't be told
+          // apart from unset, but re-parsing "0" is cheap.
+          if(0.0 == value)
           {
-            data.Binary(value);
-            send_data = (value != p_value->exchange(value, std::memory_order_release)) || send_data;
+            std::string_view value_str{data.Value()};
+            if(const auto [_, ec] = std::from_chars(value_str.begin(),
+                                                    value_str.end(),
+                                                    value);
+               std::errc{} != ec)
+            {
+              return;
+            }
 
-            l_data_out.emplace_back(std::move(data));
+            data.Binary(value);
           }
+
+          send_data = (value != p_value->Store(value, data.Timestamp(), values::Quality::Measured)) || send_data;
+
+          l_data_out.emplace_back(std::move(data));
         };
 
-        std::ignore = l_values_store.Find(add_value_to_store, metric_id);
+        if(const auto slot = m_store_cache.Resolve(l_values_store, metric_id);
+           values::Store::no_slot != slot)
+        {
+          add_value_to_store(&l_values_store.Value(slot));
+        }
       }
 
       l_data_in.clear(yy_data::ClearAction::Keep);
@@ -103,7 +122,7 @@ void CacheHandler::Run(std::stop_token p_stop_token)
     if(0 == --spin)
     {
       spin = spin_max; // Reset spin count.
-      m_cache_queue.QWait(p_stop_token, [this] { return !m_cache_queue.QEmpty();});
+      m_cache_lanes.QWait(p_stop_token);
     }
   }
 }
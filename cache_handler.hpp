@@ -32,8 +32,10 @@
 #include "actions_handler_fwd.hpp"
 #include "actions_store.hpp"
 #include "values_store.hpp"
+#include "values_store_cache.hpp"
 
 #include "yy_values/yy_values_metric_data.hpp"
+#include "values_metric_data_lanes.hpp"
 #include "values_metric_data_queue.hpp"
 
 namespace yafiyogi::mendel {
@@ -42,8 +44,9 @@ class CacheHandler
 {
   public:
     CacheHandler(values::StorePtr p_values_store,
-                 values::MetricDataQueueReader && p_cache_queue,
-                 values::MetricDataQueueWriter && p_action_queue);
+                 values::MetricDataLanes && p_cache_lanes,
+                 values::MetricDataLaneWriter && p_action_queue,
+                 size_type p_cache_capacity = values::StoreCache::default_capacity);
 
     void Run(std::stop_token p_stop_token);
 
@@ -52,8 +55,9 @@ class CacheHandler
     using value_ptr = values::Store::value_ptr;
 
     values::StorePtr m_values_store{};
-    values::MetricDataQueueReader m_cache_queue;
-    values::MetricDataQueueWriter m_action_queue;
+    values::StoreCache m_store_cache{};
+    values::MetricDataLanes m_cache_lanes;
+    values::MetricDataLaneWriter m_action_queue;
 };
 
 } // namespace yafiyogi::mendel
@@ -24,6 +24,9 @@
 
 */
 
+#include <chrono>
+#include <memory>
+
 #include "fmt/ranges.h"
 #include "spdlog/spdlog.h"
 
@@ -36,6 +39,7 @@
 #include "action.hpp"
 #include "action_kalman.hpp"
 #include "actions_store.hpp"
+#include "kalman_batch.hpp"
 #include "values_store.hpp"
 
 #include "configure_actions.hpp"
@@ -62,6 +66,69 @@ constexpr auto handler_types =
       {"kalman"sv, ActionType::Kalman}
 });
 
+constexpr auto kalman_modes =
+  yy_data::make_lookup<std::string_view, actions::KalmanMode>(
+    actions::KalmanMode::Auto,
+    {
+      {"auto"sv, actions::KalmanMode::Auto},
+      {"batch"sv, actions::KalmanMode::Batch},
+      {"matrix"sv, actions::KalmanMode::Matrix},
+      {"sequential"sv, actions::KalmanMode::Sequential}
+});
+
+constexpr auto kalman_models =
+  yy_data::make_lookup<std::string_view, actions::KalmanModel>(
+    actions::KalmanModel::RandomWalk,
+    {
+      {"constant_velocity"sv, actions::KalmanModel::ConstantVelocity},
+      {"random_walk"sv, actions::KalmanModel::RandomWalk}
+});
+
+actions::KalmanModel decode_kalman_model(const YAML::Node & yaml_model)
+{
+  std::string model_name{yy_util::to_lower(
+    yy_util::trim(yy_util::yaml_get_value<std::string_view>(yaml_model, "random_walk")))};
+
+  return kalman_models.lookup(model_name);
+}
+
+actions::KalmanMode decode_kalman_mode(const YAML::Node & yaml_mode)
+{
+  std::string mode_name{yy_util::to_lower(
+    yy_util::trim(yy_util::yaml_get_value<std::string_view>(yaml_mode, "auto")))};
+
+  return kalman_modes.lookup(mode_name);
+}
+
+// Seconds to a timestamp duration. Zero (off) if not set.
+timestamp_type decode_seconds(const YAML::Node & yaml_seconds)
+{
+  if(const double seconds = yy_util::yaml_get_value<double>(yaml_seconds, 0.0);
+     seconds > 0.0)
+  {
+    return std::chrono::duration_cast<timestamp_type>(std::chrono::duration<double>{seconds});
+  }
+
+  return timestamp_type{};
+}
+
+actions::ActionSchedule decode_schedule(std::string_view p_action_id,
+                                        const YAML::Node & yaml_action)
+{
+  actions::ActionSchedule schedule{decode_seconds(yaml_action["period"sv]),
+                                   decode_seconds(yaml_action["idle_timeout"sv])};
+
+  if(!schedule.empty())
+  {
+    spdlog::info("    [{}] period [{}s] idle timeout [{}s]"sv,
+                 p_action_id,
+                 std::chrono::duration<double>{schedule.period}.count(),
+                 std::chrono::duration<double>{schedule.idle}.count());
+  }
+
+  return schedule;
+}
+
 ActionType decode_action_type(const YAML::Node & yaml_type)
 {
   if(!yaml_type)
@@ -77,7 +144,8 @@ ActionType decode_action_type(const YAML::Node & yaml_type)
 
 void configure_kalman(const YAML::Node & yaml_kalman,
                       actions::StoreBuilder & actions_builder,
-                      values::StoreBuilder & values_builder)
+                      values::StoreBuilder & values_builder,
+                      actions::KalmanBatchesObsPtr p_batches)
 {
   if(yaml_kalman)
   {
@@ -131,9 +199,19 @@ void configure_kalman(const YAML::Node & yaml_kalman,
             accuracy /= 100.0;
           }
 
+          // 'max_age' is in seconds.
+          timestamp_type max_age{};
+          if(const double max_age_seconds = yy_util::yaml_get_value<double>(yaml_value["max_age"sv], 0.0);
+             max_age_seconds > 0.0)
+          {
+            max_age = std::chrono::duration_cast<timestamp_type>(std::chrono::duration<double>{max_age_seconds});
+            spdlog::info("    input [{}] max age [{}s]"sv, input, max_age_seconds);
+          }
+
           options.emplace_back(yy_values::MetricId{input},
                                std::string{output},
-                               accuracy);
+                               accuracy,
+                               max_age);
 
           inputs.emplace_back(std::string{input});
           outputs.emplace_back(std::string{output});
@@ -154,19 +232,28 @@ void configure_kalman(const YAML::Node & yaml_kalman,
           std::make_unique<actions::KalmanAction>(action_id,
                                                   output_topic,
                                                   output_value_id,
-                                                  std::move(options))};
+                                                  std::move(options),
+                                                  decode_kalman_mode(yaml_kalman["mode"sv]),
+                                                  decode_kalman_model(yaml_kalman["model"sv]),
+                                                  p_batches)};
 
         for(auto & input: inputs)
         {
-          values_builder.Add(input);
+          values_builder.Add(input, values::Writer::Cache);
         }
 
+        Outputs output_ids{};
+        output_ids.reserve(outputs.size());
         for(auto & output: outputs)
         {
-          values_builder.Add(fmt::format("{}:{}"sv, output_value_id, output));
+          output_ids.emplace_back(fmt::format("{}:{}"sv, output_value_id, output));
+          values_builder.Add(output_ids.back(), values::Writer::Actions);
         }
 
-        actions_builder.Add(std::move(action), inputs);
+        actions_builder.Add(std::move(action),
+                            inputs,
+                            output_ids,
+                            decode_schedule(action_id, yaml_kalman));
       }
     }
     else
@@ -183,6 +270,7 @@ void configure_actions(const YAML::Node & yaml_actions,
                        values::StoreBuilder & values_store)
 {
   actions::StoreBuilder actions{};
+  auto batches{std::make_unique<actions::KalmanBatches>()};
 
   if(yaml_actions && !yy_util::yaml_is_scalar(yaml_actions))
   {
@@ -191,7 +279,10 @@ void configure_actions(const YAML::Node & yaml_actions,
       switch(decode_action_type(yaml_action["type"sv]))
       {
       case ActionType::Kalman:
-        configure_kalman(yaml_action, actions_store, values_store);
+        configure_kalman(yaml_action,
+                         actions_store,
+                         values_store,
+                         actions::KalmanBatchesObsPtr{batches.get()});
         break;
 
       case ActionType::None:
@@ -201,6 +292,11 @@ void configure_actions(const YAML::Node & yaml_actions,
       }
     }
   }
+
+  if(!batches->empty())
+  {
+    actions_store.AddEngine(std::move(batches));
+  }
 }
 
 } // namespace yafiyogi::mendel
@@ -24,10 +24,13 @@
 
 */
 
+#include <algorithm>
 #include <string>
 
+#include "fmt/format.h"
 #include "spdlog/spdlog.h"
 
+#include "yy_cpp/yy_string_util.h"
 #include "yy_cpp/yy_yaml_util.h"
 
 #include "configure_mqtt_handlers.h"
@@ -42,15 +45,49 @@ namespace yafiyogi::mendel {
 using namespace std::string_literals;
 using namespace std::string_view_literals;
 
+namespace {
+
+constexpr std::string_view g_default_share_group{"mendel"};
+
+} // anonymous namespace
+
 mqtt_client_config configure_mqtt_client(const YAML::Node & yaml_mqtt,
                                          yy_values::MetricsMap & p_values_config)
 {
   auto handlers = configure_mqtt_handlers(yaml_mqtt["handlers"sv], p_values_config);
-  auto [subscriptions, topics] = configure_mqtt_topics(yaml_mqtt["topics"sv], handlers);
+  auto [subscriptions, subscription_handlers, topics] = configure_mqtt_topics(yaml_mqtt["topics"sv], handlers);
+
+  const size_type client_count = static_cast<size_type>(std::max(1, yy_util::yaml_get_value(yaml_mqtt["clients"sv], 1)));
+  const size_type parser_count = static_cast<size_type>(std::max(1, yy_util::yaml_get_value(yaml_mqtt["parsers"sv], 1)));
+  std::string share_group{yy_util::trim(yy_util::yaml_get_value<std::string_view>(yaml_mqtt["share_group"sv], ""))};
+
+  if(share_group.empty() && (client_count > 1))
+  {
+    share_group = g_default_share_group;
+  }
+
+  spdlog::info("   clients    : [{}]"sv, client_count);
+  spdlog::info("   parsers    : [{}]"sv, parser_count);
+
+  if(!share_group.empty())
+  {
+    // MQTT v5 shared subscriptions: the broker spreads messages
+    // matching the filter across all clients in the group.
+    spdlog::info("   share group: [{}]"sv, share_group);
+
+    for(auto & subscription : subscriptions)
+    {
+      subscription = fmt::format("$share/{}/{}"sv, share_group, subscription);
+    }
+  }
 
   return mqtt_client_config{std::move(handlers),
                             std::move(subscriptions),
-                            std::move(topics)};
+                            std::move(subscription_handlers),
+                            std::move(topics),
+                            client_count,
+                            parser_count,
+                            std::move(share_group)};
 }
 
 } // namespace yafiyogi::mendel
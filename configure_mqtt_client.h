@@ -26,8 +26,12 @@
 
 #pragma once
 
+#include <string>
+
 #include "yy_tp_util/yaml_fwd.h"
 
+#include "yy_cpp/yy_types.hpp"
+
 #include "yy_values/yy_values_metric.hpp"
 
 #include "mqtt_handler_fwd.h"
@@ -39,7 +43,11 @@ struct mqtt_client_config final
 {
     MqttHandlerStore handlers{};
     Subscriptions subscriptions{};
+    SubscriptionHandlers subscription_handlers{};
     Topics topics{};
+    size_type client_count = 1;
+    size_type parser_count = 1;
+    std::string share_group{};
 };
 
 mqtt_client_config configure_mqtt_client(const YAML::Node & yaml_mqtt,
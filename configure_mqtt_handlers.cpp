@@ -24,8 +24,12 @@
 
 */
 
+#include <algorithm>
+#include <bit>
 #include <memory>
+#include <string>
 #include <string_view>
+#include <utility>
 
 #include "fmt/format.h"
 #include "fmt/compile.h"
@@ -38,7 +42,11 @@
 #include "yy_cpp/yy_yaml_util.h"
 
 #include "mqtt_handler.h"
+#include "mqtt_handler_binary.h"
+#include "mqtt_handler_binary_json.h"
 #include "mqtt_handler_json.h"
+#include "mqtt_handler_json_samples.h"
+#include "mqtt_handler_text.h"
 #include "mqtt_handler_value.h"
 #include "values_config.h"
 
@@ -51,13 +59,59 @@ using namespace fmt::literals;
 
 namespace {
 
-const boost::json::parse_options g_json_options{ .numbers = boost::json::number_precision::none};
+// Numbers are decoded by the parser & passed on to the cache stage.
+const boost::json::parse_options g_json_options{ .numbers = boost::json::number_precision::imprecise};
+
+// Combined json handler ids start with this, configured ids can't.
+constexpr char g_combined_prefix = '+';
 
 constexpr auto handler_types =
   yy_data::make_lookup<std::string_view, MqttHandler::type>(MqttHandler::type::Json,
                                                             {{"json"sv, MqttHandler::type::Json},
                                                              {"text"sv, MqttHandler::type::Text},
-                                                             {"value"sv, MqttHandler::type::Value}});
+                                                             {"value"sv, MqttHandler::type::Value},
+                                                             {"binary"sv, MqttHandler::type::Binary},
+                                                             {"cbor"sv, MqttHandler::type::Cbor},
+                                                             {"msgpack"sv, MqttHandler::type::Msgpack}});
+
+constexpr auto compression_types =
+  yy_data::make_lookup<std::string_view, MqttHandler::compression>(MqttHandler::compression::None,
+                                                                   {{"none"sv, MqttHandler::compression::None},
+                                                                    {"deflate"sv, MqttHandler::compression::Deflate},
+                                                                    {"gzip"sv, MqttHandler::compression::Gzip}});
+
+MqttHandler::compression decode_compression(const YAML::Node & yaml_compression)
+{
+  std::string compression_name{yy_util::to_lower(yy_util::trim(yy_util::yaml_get_value<std::string_view>(yaml_compression, "none")))};
+
+  return compression_types.lookup(compression_name);
+}
+
+// Nanoseconds per sample timestamp unit.
+constexpr auto timestamp_units =
+  yy_data::make_lookup<std::string_view, double>(1e9,
+                                                 {{"s"sv, 1e9},
+                                                  {"ms"sv, 1e6},
+                                                  {"us"sv, 1e3},
+                                                  {"ns"sv, 1.0}});
+
+constexpr auto endian_types =
+  yy_data::make_lookup<std::string_view, std::endian>(std::endian::little,
+                                                      {{"little"sv, std::endian::little},
+                                                       {"big"sv, std::endian::big}});
+
+std::endian decode_endian(const YAML::Node & yaml_endian,
+                          std::endian p_default)
+{
+  if(!yaml_endian)
+  {
+    return p_default;
+  }
+
+  std::string endian_name{yy_util::to_lower(yy_util::trim(yy_util::yaml_get_value<std::string_view>(yaml_endian)))};
+
+  return endian_types.lookup(endian_name);
+}
 
 MqttHandler::type decode_type(const YAML::Node & yaml_type)
 {
@@ -67,25 +121,36 @@ MqttHandler::type decode_type(const YAML::Node & yaml_type)
   return handler_types.lookup(type_name);
 }
 
-MqttHandlerPtr configure_json_handler(std::string_view p_id,
-                                      const YAML::Node & yaml_json_handler,
-                                      yy_values::MetricsMap & values_metrics)
+// Json pointer property configuration shared by the json, cbor & msgpack
+// handlers. 'create_handler' makes the handler from the json pointer config.
+template<typename CreateHandler>
+MqttHandlerPtr configure_pointer_handler(std::string_view p_id,
+                                         const YAML::Node & yaml_pointer_handler,
+                                         yy_values::MetricsMap & values_metrics,
+                                         CreateHandler && create_handler)
 {
-  MqttHandlerPtr mqtt_json_handler{};
-  auto yaml_properties = yaml_json_handler["properties"sv];
+  MqttHandlerPtr mqtt_pointer_handler{};
+  auto yaml_properties = yaml_pointer_handler["properties"sv];
   if(yaml_properties && (0 != yaml_properties.size()))
   {
     MqttJsonHandler::builder_type json_pointer_builder{};
+    MqttJsonHandler::PointerMetrics pointer_metrics{};
     int metrics_count = 0;
+    size_type pointer_count = 0;
     std::string json_pointer{};
     std::string_view property{};
 
-    auto do_add_property = [&property, &json_pointer, &json_pointer_builder, &metrics_count]
+    auto do_add_property = [&property, &json_pointer, &json_pointer_builder, &pointer_metrics, &pointer_count, &metrics_count]
                            (auto visitor_values_metrics, auto /* pos */) {
       if(nullptr != visitor_values_metrics)
       {
         auto [builder_metrics, added] = json_pointer_builder.add_pointer(json_pointer,
                                                                          yy_values::Metrics{});
+        if(added)
+        {
+          ++pointer_count;
+        }
+
         if(nullptr != builder_metrics)
         {
           for(auto & metric : *visitor_values_metrics)
@@ -95,6 +160,8 @@ MqttHandlerPtr configure_json_handler(std::string_view p_id,
               ++metrics_count;
               spdlog::info("       metric [{}] added."sv,
                            metric->Id().Name());
+              pointer_metrics.emplace_back(json_pointer,
+                                           json_handler_detail::MetricObsPtr{std::to_address(metric)});
               builder_metrics->emplace_back(std::move(metric));
             }
           }
@@ -146,25 +213,338 @@ MqttHandlerPtr configure_json_handler(std::string_view p_id,
 
     if(metrics_count > 0)
     {
-      auto create_json_pointer_config = [&json_pointer_builder]() {
-        return json_pointer_builder.create(g_json_options.max_depth);
-      };
-
-      mqtt_json_handler = std::make_unique<MqttJsonHandler>(p_id,
-                                                            g_json_options,
-                                                            create_json_pointer_config(),
-                                                            metrics_count);
+      mqtt_pointer_handler = create_handler(json_pointer_builder.create(g_json_options.max_depth),
+                                            std::move(pointer_metrics),
+                                            pointer_count,
+                                            static_cast<size_type>(metrics_count));
     }
   }
 
-  return mqtt_json_handler;
+  return mqtt_pointer_handler;
 }
 
-MqttHandlerPtr configure_text_handler(std::string_view /* p_id */,
-                                      const YAML::Node & /* yaml_text_handler */,
-                                      yy_values::MetricsMap & /* values_metrics */)
+// Split a json pointer in to its (unescaped) reference tokens.
+MqttJsonSamplesHandler::PathTokens json_pointer_tokens(std::string_view p_pointer)
 {
-  return MqttHandlerPtr{};
+  MqttJsonSamplesHandler::PathTokens tokens{};
+
+  if(p_pointer.empty())
+  {
+    return tokens;
+  }
+
+  if('/' == p_pointer.front())
+  {
+    p_pointer.remove_prefix(1);
+  }
+
+  while(true)
+  {
+    const auto pos = p_pointer.find('/');
+    const std::string_view escaped{p_pointer.substr(0, pos)};
+
+    std::string token{};
+    token.reserve(escaped.size());
+    for(size_type idx = 0; idx < escaped.size(); ++idx)
+    {
+      if(('~' == escaped[idx]) && ((idx + 1) < escaped.size()))
+      {
+        ++idx;
+        token += ('1' == escaped[idx]) ? '/' : '~';
+      }
+      else
+      {
+        token += escaped[idx];
+      }
+    }
+
+    tokens.emplace_back(std::move(token));
+
+    if(std::string_view::npos == pos)
+    {
+      break;
+    }
+
+    p_pointer.remove_prefix(pos + 1);
+  }
+
+  return tokens;
+}
+
+MqttHandlerPtr configure_json_samples_handler(std::string_view p_id,
+                                              const YAML::Node & yaml_json_handler,
+                                              yy_values::MetricsMap & values_metrics)
+{
+  MqttHandlerPtr mqtt_samples_handler{};
+  auto yaml_properties = yaml_json_handler["properties"sv];
+  if(!yaml_properties || (0 == yaml_properties.size()))
+  {
+    return mqtt_samples_handler;
+  }
+
+  const std::string_view samples_pointer{yy_util::trim(yy_util::yaml_get_value<std::string_view>(yaml_json_handler["samples"sv]))};
+  std::string timestamp_field{yy_util::trim(yy_util::yaml_get_value<std::string_view>(yaml_json_handler["timestamp"sv], "ts"))};
+  const std::string units{yy_util::to_lower(yy_util::trim(yy_util::yaml_get_value<std::string_view>(yaml_json_handler["timestamp_units"sv], "s")))};
+
+  spdlog::info("     - samples [{}] timestamp=[{}] units=[{}]:"sv,
+               samples_pointer,
+               timestamp_field,
+               units);
+
+  MqttJsonSamplesHandler::SampleFields fields{};
+  fields.reserve(yaml_properties.size());
+  size_type metrics_count = 0;
+  std::string_view field{};
+  std::string_view property{};
+
+  auto do_add_property = [&field, &property, &fields, &metrics_count]
+                         (auto visitor_values_metrics, auto /* pos */) {
+    if(nullptr != visitor_values_metrics)
+    {
+      json_samples_detail::SampleField sample_field{std::string{field}, yy_values::Metrics{}};
+
+      for(auto & metric : *visitor_values_metrics)
+      {
+        if(metric && (metric->Property() == property))
+        {
+          ++metrics_count;
+          spdlog::info("       metric [{}] added."sv,
+                       metric->Id().Name());
+          sample_field.metrics.emplace_back(std::move(metric));
+        }
+      }
+
+      if(!sample_field.metrics.empty())
+      {
+        fields.emplace_back(std::move(sample_field));
+      }
+    }
+  };
+
+  yy_data::flat_set<std::string_view> properties{};
+  properties.reserve(yaml_properties.size());
+
+  spdlog::trace("        [line {}]."sv,
+                yaml_properties.Mark().line + 1);
+  if(const bool is_sequence = yaml_properties.IsSequence();
+     is_sequence || yaml_properties.IsMap())
+  {
+    for(const auto & yaml_property : yaml_properties)
+    {
+      if(is_sequence && yaml_property.IsScalar())
+      {
+        property = yy_util::trim(yaml_property.as<std::string_view>());
+        field = property;
+      }
+      else if(!is_sequence)
+      {
+        field = yy_util::trim(yy_util::yaml_get_value<std::string_view>(yaml_property.first));
+        property = yy_util::trim(yy_util::yaml_get_value<std::string_view>(yaml_property.second));
+
+        // Fields are keys of each sample object.
+        if(!field.empty() && ('/' == field.front()))
+        {
+          field.remove_prefix(1);
+        }
+      }
+
+      spdlog::info("     - property [{}] field=[{}]:"sv,
+                   property,
+                   field);
+
+      if(!field.empty()
+         && !property.empty())
+      {
+        // Avoid duplicates.
+        if(auto [ignore, inserted] = properties.emplace(property);
+           inserted)
+        {
+          std::ignore = values_metrics.find_value(do_add_property, p_id);
+        }
+        else
+        {
+          spdlog::warn("   * already added!"sv);
+        }
+      }
+    }
+  }
+
+  if(metrics_count > 0)
+  {
+    mqtt_samples_handler = std::make_unique<MqttJsonSamplesHandler>(p_id,
+                                                                    g_json_options,
+                                                                    json_pointer_tokens(samples_pointer),
+                                                                    std::move(timestamp_field),
+                                                                    timestamp_units.lookup(units),
+                                                                    std::move(fields),
+                                                                    metrics_count);
+  }
+
+  return mqtt_samples_handler;
+}
+
+MqttHandlerPtr configure_json_handler(std::string_view p_id,
+                                      const YAML::Node & yaml_json_handler,
+                                      yy_values::MetricsMap & values_metrics)
+{
+  // Batched uploads: an array of samples, each with its own timestamp.
+  if(yaml_json_handler["samples"sv])
+  {
+    return configure_json_samples_handler(p_id, yaml_json_handler, values_metrics);
+  }
+
+  auto create_json_handler = [p_id](MqttJsonHandler::handler_config_type && p_config,
+                                    MqttJsonHandler::PointerMetrics && p_pointer_metrics,
+                                    size_type p_pointer_count,
+                                    size_type p_metrics_count) -> MqttHandlerPtr {
+    return std::make_unique<MqttJsonHandler>(p_id,
+                                             g_json_options,
+                                             std::move(p_config),
+                                             std::move(p_pointer_metrics),
+                                             p_pointer_count,
+                                             p_metrics_count);
+  };
+
+  return configure_pointer_handler(p_id, yaml_json_handler, values_metrics, create_json_handler);
+}
+
+template<typename HandlerType>
+MqttHandlerPtr configure_binary_json_handler(std::string_view p_id,
+                                             const YAML::Node & yaml_binary_json_handler,
+                                             yy_values::MetricsMap & values_metrics)
+{
+  auto create_binary_json_handler = [p_id](typename HandlerType::handler_config_type && p_config,
+                                           MqttJsonHandler::PointerMetrics && /* p_pointer_metrics */,
+                                           size_type p_pointer_count,
+                                           size_type p_metrics_count) -> MqttHandlerPtr {
+    return std::make_unique<HandlerType>(p_id,
+                                         std::move(p_config),
+                                         g_json_options.max_depth,
+                                         p_pointer_count,
+                                         p_metrics_count);
+  };
+
+  return configure_pointer_handler(p_id, yaml_binary_json_handler, values_metrics, create_binary_json_handler);
+}
+
+MqttHandlerPtr configure_text_handler(std::string_view p_id,
+                                      const YAML::Node & yaml_text_handler,
+                                      yy_values::MetricsMap & values_metrics)
+{
+  MqttHandlerPtr mqtt_text_handler{};
+  auto yaml_patterns = yaml_text_handler["patterns"sv];
+  if(!yaml_patterns || !yaml_patterns.IsSequence() || (0 == yaml_patterns.size()))
+  {
+    spdlog::warn("       no patterns found!"sv);
+    return mqtt_text_handler;
+  }
+
+  yy_values::Metrics handler_metrics{};
+  auto do_get_metrics = [&handler_metrics]
+                        (auto visitor_values_metrics, auto /* pos */) {
+    if(nullptr != visitor_values_metrics)
+    {
+      handler_metrics.reserve(visitor_values_metrics->size());
+
+      for(auto & metric : *visitor_values_metrics)
+      {
+        if(metric)
+        {
+          handler_metrics.emplace_back(std::move(metric));
+        }
+      }
+    }
+  };
+
+  std::ignore = values_metrics.find_value(do_get_metrics, p_id);
+
+  RE2::Options options{};
+  options.set_log_errors(false);
+
+  auto pattern_set{std::make_unique<RE2::Set>(options, RE2::UNANCHORED)};
+  MqttTextHandler::Patterns patterns{};
+  patterns.reserve(yaml_patterns.size());
+  yy_data::flat_set<const text_handler_detail::Metric *> metrics_used{};
+
+  spdlog::trace("        [line {}]."sv,
+                yaml_patterns.Mark().line + 1);
+  for(const auto & yaml_pattern : yaml_patterns)
+  {
+    const std::string_view pattern{yy_util::trim(yy_util::yaml_get_value<std::string_view>(yaml_pattern))};
+    spdlog::info("     - pattern [{}]:"sv, pattern);
+
+    auto regex{std::make_unique<RE2>(re2::StringPiece{pattern.data(), pattern.size()}, options)};
+    if(!regex->ok())
+    {
+      spdlog::error("   * invalid pattern [{}]!"sv, regex->error());
+      continue;
+    }
+
+    // Named capture groups are the properties of the metrics.
+    text_handler_detail::PatternGroups groups{};
+    int submatch_count = 0;
+    for(const auto & [property, group] : regex->NamedCapturingGroups())
+    {
+      text_handler_detail::MetricObsPtrs group_metrics{};
+
+      for(auto & metric : handler_metrics)
+      {
+        if(metric->Property() == property)
+        {
+          spdlog::info("       metric [{}] added."sv,
+                       metric->Id().Name());
+          group_metrics.emplace_back(text_handler_detail::MetricObsPtr{std::to_address(metric)});
+          std::ignore = metrics_used.emplace(std::to_address(metric));
+        }
+      }
+
+      if(group_metrics.empty())
+      {
+        spdlog::warn("       no metrics for group [{}]!"sv, property);
+      }
+      else
+      {
+        submatch_count = std::max(submatch_count, group + 1);
+        groups.emplace_back(group, std::move(group_metrics));
+      }
+    }
+
+    if(groups.empty())
+    {
+      spdlog::warn("   * no named groups with metrics!"sv);
+      continue;
+    }
+
+    std::string error{};
+    if(const int pattern_idx = pattern_set->Add(re2::StringPiece{pattern.data(), pattern.size()}, &error);
+       static_cast<size_type>(pattern_idx) != patterns.size())
+    {
+      spdlog::error("   * invalid pattern [{}]!"sv, error);
+      continue;
+    }
+
+    patterns.emplace_back(std::move(regex), std::move(groups), submatch_count);
+  }
+
+  if(patterns.empty())
+  {
+    spdlog::warn("       no metrics found!."sv);
+  }
+  else if(!pattern_set->Compile())
+  {
+    spdlog::error("   * failed to compile patterns!"sv);
+  }
+  else
+  {
+    const size_type metrics_count = metrics_used.size();
+    mqtt_text_handler = std::make_unique<MqttTextHandler>(p_id,
+                                                          std::move(pattern_set),
+                                                          std::move(patterns),
+                                                          std::move(handler_metrics),
+                                                          metrics_count);
+  }
+
+  return mqtt_text_handler;
 }
 
 MqttHandlerPtr configure_value_handler(std::string_view p_id,
@@ -205,6 +585,108 @@ MqttHandlerPtr configure_value_handler(std::string_view p_id,
   return handler;
 }
 
+MqttHandlerPtr configure_binary_handler(std::string_view p_id,
+                                        const YAML::Node & yaml_binary_handler,
+                                        yy_values::MetricsMap & values_metrics)
+{
+  MqttHandlerPtr mqtt_binary_handler{};
+  auto yaml_fields = yaml_binary_handler["fields"sv];
+  if(!yaml_fields || !yaml_fields.IsSequence() || (0 == yaml_fields.size()))
+  {
+    spdlog::warn("       no fields found!"sv);
+    return mqtt_binary_handler;
+  }
+
+  yy_values::Metrics handler_metrics{};
+  auto do_get_metrics = [&handler_metrics]
+                        (auto visitor_values_metrics, auto /* pos */) {
+    if(nullptr != visitor_values_metrics)
+    {
+      handler_metrics.reserve(visitor_values_metrics->size());
+
+      for(auto & metric : *visitor_values_metrics)
+      {
+        if(metric)
+        {
+          handler_metrics.emplace_back(std::move(metric));
+        }
+      }
+    }
+  };
+
+  std::ignore = values_metrics.find_value(do_get_metrics, p_id);
+
+  const std::endian default_endian = decode_endian(yaml_binary_handler["endian"sv], std::endian::little);
+  MqttBinaryHandler::Fields fields{};
+  fields.reserve(yaml_fields.size());
+  yy_data::flat_set<const binary_handler_detail::Metric *> metrics_used{};
+  size_type length = 0;
+
+  spdlog::trace("        [line {}]."sv,
+                yaml_fields.Mark().line + 1);
+  for(const auto & yaml_field : yaml_fields)
+  {
+    const std::string_view property{yy_util::trim(yy_util::yaml_get_value<std::string_view>(yaml_field["property"sv]))};
+    const std::string_view type_name{yy_util::trim(yy_util::yaml_get_value<std::string_view>(yaml_field["type"sv]))};
+    const size_type offset = yy_util::yaml_get_value<size_type>(yaml_field["offset"sv], 0);
+    const std::endian endian = decode_endian(yaml_field["endian"sv], default_endian);
+
+    spdlog::info("     - property [{}] offset=[{}] type=[{}] endian=[{}]:"sv,
+                 property,
+                 offset,
+                 type_name,
+                 std::endian::big == endian ? "big"sv : "little"sv);
+
+    const auto type = binary_handler_detail::field_type(yy_util::to_lower(type_name), endian);
+    if(nullptr == type.decoder)
+    {
+      spdlog::error("   * unknown field type [{}]!"sv, type_name);
+      continue;
+    }
+
+    binary_handler_detail::MetricObsPtrs field_metrics{};
+    for(auto & metric : handler_metrics)
+    {
+      if(metric->Property() == property)
+      {
+        spdlog::info("       metric [{}] added."sv,
+                     metric->Id().Name());
+        field_metrics.emplace_back(binary_handler_detail::MetricObsPtr{std::to_address(metric)});
+        std::ignore = metrics_used.emplace(std::to_address(metric));
+      }
+    }
+
+    if(field_metrics.empty())
+    {
+      spdlog::warn("       no metrics found!."sv);
+      continue;
+    }
+
+    length = std::max(length, offset + type.size);
+    fields.emplace_back(type, offset, std::move(field_metrics));
+  }
+
+  if(fields.empty())
+  {
+    spdlog::warn("       no fields configured!."sv);
+  }
+  else
+  {
+    // A payload must hold every field, but may be declared longer.
+    length = std::max(length, yy_util::yaml_get_value<size_type>(yaml_binary_handler["length"sv], 0));
+    spdlog::info("     length [{}]"sv, length);
+
+    const size_type metrics_count = metrics_used.size();
+    mqtt_binary_handler = std::make_unique<MqttBinaryHandler>(p_id,
+                                                              std::move(fields),
+                                                              length,
+                                                              std::move(handler_metrics),
+                                                              metrics_count);
+  }
+
+  return mqtt_binary_handler;
+}
+
 } // anonymous namespace
 
 MqttHandlerStore configure_mqtt_handlers(const YAML::Node & yaml_handlers,
@@ -243,12 +725,38 @@ MqttHandlerStore configure_mqtt_handlers(const YAML::Node & yaml_handlers,
         case MqttHandler::type::Value:
           handler = configure_value_handler(l_id, yaml_handler, values_config);
           break;
+
+        case MqttHandler::type::Binary:
+          handler = configure_binary_handler(l_id, yaml_handler, values_config);
+          break;
+
+        case MqttHandler::type::Cbor:
+          handler = configure_binary_json_handler<MqttCborHandler>(l_id, yaml_handler, values_config);
+          break;
+
+        case MqttHandler::type::Msgpack:
+          handler = configure_binary_json_handler<MqttMsgpackHandler>(l_id, yaml_handler, values_config);
+          break;
       }
 
       if(handler)
       {
+        if(const auto compression = decode_compression(yaml_handler["compression"sv]);
+           MqttHandler::compression::None != compression)
+        {
+          spdlog::info("   - compression [{}]"sv, yaml_handler["compression"sv].as<std::string_view>());
+          handler->Compression(compression);
+        }
+
         if(const auto & id = handler->Id();
-           !id.empty())
+           !id.empty() && (g_combined_prefix == id.front()))
+        {
+          spdlog::error("MQTT Handler id [{}] can't start with '{}'. Ignoring [line {}]"sv,
+                        id,
+                        g_combined_prefix,
+                        yaml_handler.Mark().line + 1);
+        }
+        else if(!id.empty())
         {
           if(auto [handler_pos, emplaced] = handler_store.emplace(std::move(id), std::move(handler));
              !emplaced)
@@ -273,4 +781,118 @@ MqttHandlerStore configure_mqtt_handlers(const YAML::Node & yaml_handlers,
   return handler_store;
 }
 
+void combine_json_handlers(MqttHandlerList & p_handlers,
+                           MqttHandlerStore & p_handlers_store)
+{
+  // Only handlers sharing a compression can share a parse.
+  auto compression = MqttHandler::compression::None;
+  if(auto first_json = std::find_if(p_handlers.begin(), p_handlers.end(), [](const MqttHandlerObsPtr & handler) {
+    return nullptr != dynamic_cast<const MqttJsonHandler *>(std::to_address(handler));
+  });
+     p_handlers.end() != first_json)
+  {
+    compression = (*first_json)->Compression();
+  }
+
+  auto is_json_handler = [compression](const MqttHandlerObsPtr & handler) {
+    return (nullptr != dynamic_cast<const MqttJsonHandler *>(std::to_address(handler)))
+      && (compression == handler->Compression());
+  };
+
+  if(std::count_if(p_handlers.begin(), p_handlers.end(), is_json_handler) < 2)
+  {
+    return;
+  }
+
+  // '+a+b', which can't clash with a configured handler id.
+  std::string combined_id{};
+  for(const auto & handler : p_handlers)
+  {
+    if(is_json_handler(handler))
+    {
+      combined_id += g_combined_prefix;
+      combined_id += handler->Id();
+    }
+  }
+
+  MqttHandlerObsPtr combined_handler{};
+  auto do_find_handler = [&combined_handler](auto mqtt_handler, auto /* pos */) {
+    if(nullptr != dynamic_cast<const MqttJsonCombinedHandler *>(mqtt_handler->get()))
+    {
+      combined_handler = MqttHandlerObsPtr{mqtt_handler->get()};
+    }
+  };
+
+  std::ignore = p_handlers_store.find_value(do_find_handler, combined_id);
+
+  if(!combined_handler)
+  {
+    MqttJsonCombinedHandler::builder_type json_pointer_builder{};
+    size_type pointer_count = 0;
+    size_type metrics_count = 0;
+
+    for(const auto & handler : p_handlers)
+    {
+      if(is_json_handler(handler))
+      {
+        const auto & json_handler = dynamic_cast<const MqttJsonHandler &>(*handler);
+
+        for(const auto & [json_pointer, metric] : json_handler.Pointers())
+        {
+          if(auto [builder_metrics, added] = json_pointer_builder.add_pointer(json_pointer,
+                                                                              MqttJsonCombinedHandler::MetricObsPtrs{});
+             nullptr != builder_metrics)
+          {
+            if(added)
+            {
+              ++pointer_count;
+            }
+
+            builder_metrics->emplace_back(metric);
+            ++metrics_count;
+          }
+        }
+      }
+    }
+
+    auto handler = std::make_unique<MqttJsonCombinedHandler>(combined_id,
+                                                             g_json_options,
+                                                             json_pointer_builder.create(g_json_options.max_depth),
+                                                             pointer_count,
+                                                             metrics_count);
+    handler->Compression(compression);
+    MqttHandlerObsPtr new_handler{handler.get()};
+
+    if(auto [handler_pos, emplaced] = p_handlers_store.emplace(combined_id, std::move(handler));
+       !emplaced)
+    {
+      spdlog::error("     json handler id [{}] already used. Not combining."sv, combined_id);
+      return;
+    }
+
+    combined_handler = new_handler;
+  }
+
+  spdlog::info("     combined json handlers [{}]"sv, combined_id);
+
+  // Keep the combined handler where the first json handler was.
+  MqttHandlerList handlers{};
+  handlers.reserve(p_handlers.size());
+
+  for(const auto & handler : p_handlers)
+  {
+    if(!is_json_handler(handler))
+    {
+      handlers.emplace_back(handler);
+    }
+    else if(combined_handler)
+    {
+      handlers.emplace_back(combined_handler);
+      combined_handler = MqttHandlerObsPtr{};
+    }
+  }
+
+  std::swap(p_handlers, handlers);
+}
+
 } // namespace yafiyogi::mendel
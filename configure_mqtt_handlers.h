@@ -37,4 +37,11 @@ namespace yafiyogi::mendel {
 MqttHandlerStore configure_mqtt_handlers(const YAML::Node & yaml_handlers,
                                          yy_values::MetricsMap & value_config);
 
+// Replace the json handlers in a list with a single handler that parses
+// each payload once for all of them. The combined handler is added to
+// the handler store, its id the json handler ids each prefixed with
+// '+', a prefix configured handler ids can't have.
+void combine_json_handlers(MqttHandlerList & p_handlers,
+                           MqttHandlerStore & p_handlers_store);
+
 } // namespace yafiyogi::mendel
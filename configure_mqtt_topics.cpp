@@ -24,6 +24,8 @@
 
 */
 
+#include <algorithm>
+
 #include "spdlog/spdlog.h"
 
 #include "yy_cpp/yy_find_iter_util.hpp"
@@ -33,6 +35,7 @@
 #include "yy_mqtt/yy_mqtt_util.h"
 #include "yy_values/yy_values_labels.hpp"
 
+#include "configure_mqtt_handlers.h"
 #include "mqtt_handler.h"
 
 #include "configure_mqtt_topics.h"
@@ -42,9 +45,10 @@ namespace yafiyogi::mendel {
 using namespace std::string_view_literals;
 
 mqtt_topics configure_mqtt_topics(const YAML::Node & yaml_topics,
-                                  const MqttHandlerStore & handlers_store)
+                                  MqttHandlerStore & handlers_store)
 {
   Subscriptions subscriptions{};
+  SubscriptionHandlers subscription_handlers{};
   TopicsConfig topics_config{};
 
   spdlog::info(" Configuring topics."sv);
@@ -67,6 +71,8 @@ mqtt_topics configure_mqtt_topics(const YAML::Node & yaml_topics,
         std::ignore = handlers_store.find_value(do_add_handler, handler_id).found;
       }
 
+      combine_json_handlers(mqtt_handlers, handlers_store);
+
       if(!mqtt_handlers.empty())
       {
         auto yaml_subscriptions = yaml_topic["subscriptions"sv];
@@ -85,6 +91,7 @@ mqtt_topics configure_mqtt_topics(const YAML::Node & yaml_topics,
         }
 
         subscriptions.reserve(subscriptions.size() + filters.size());
+        subscription_handlers.reserve(subscriptions.size() + filters.size());
         for(size_type idx = 0; idx < filters.size(); ++idx)
         {
           auto filter = filters[idx];
@@ -107,14 +114,32 @@ mqtt_topics configure_mqtt_topics(const YAML::Node & yaml_topics,
           if(auto [pos, found] = yy_data::find_iter(subscriptions, filter);
              !found)
           {
+            auto handlers_pos = subscription_handlers.begin() + (pos - subscriptions.begin());
+
             subscriptions.emplace(pos, std::string{filter});
+            subscription_handlers.emplace(handlers_pos, MqttHandlerList{mqtt_handlers});
+          }
+          else
+          {
+            // Filter used by more than one topic, add any new handlers.
+            auto & filter_handlers = subscription_handlers[static_cast<size_type>(pos - subscriptions.begin())];
+
+            for(const auto & handler : mqtt_handlers)
+            {
+              if(std::find(filter_handlers.begin(), filter_handlers.end(), handler) == filter_handlers.end())
+              {
+                filter_handlers.emplace_back(handler);
+              }
+            }
           }
         }
       }
     }
   }
 
-  return mqtt_topics{std::move(subscriptions), topics_config.create_automaton()};
+  return mqtt_topics{std::move(subscriptions),
+                     std::move(subscription_handlers),
+                     topics_config.create_automaton()};
 }
 
 } // namespace yafiyogi::mendel
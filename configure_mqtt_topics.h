@@ -37,12 +37,13 @@ namespace yafiyogi::mendel {
 struct mqtt_topics final
 {
     yy_quad::simple_vector<std::string> subscriptions{};
+    SubscriptionHandlers subscription_handlers{};
     Topics topics{};
 };
 
 
 mqtt_topics configure_mqtt_topics(const YAML::Node & yaml_topics,
-                                  const MqttHandlerStore & handlers);
+                                  MqttHandlerStore & handlers);
 
 
 } // namespace yafiyogi::mendel
@@ -0,0 +1,303 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <algorithm>
+#include <tuple>
+#include <utility>
+#include <vector>
+
+#include "spdlog/spdlog.h"
+
+#include "kalman_batch_kernel.hpp"
+#include "kalman_fixed.hpp"
+
+#include "kalman_batch.hpp"
+
+namespace yafiyogi::actions {
+
+using namespace std::string_view_literals;
+
+namespace {
+
+using kalman_batch_detail::Block;
+using kalman_batch_detail::g_block_lanes;
+
+template<size_type N, size_type M>
+class KalmanBatchNM final:
+      public KalmanBatch
+{
+  public:
+    using block_type = Block<N, M>;
+    using step_type = void (*)(block_type *, size_type, double, bool, const size_type *) noexcept;
+
+    KalmanBatchNM(const size_type * p_states,
+                  value_type p_process_noise,
+                  KalmanModel p_model) noexcept:
+      m_process_noise(p_process_noise),
+      m_model(p_model),
+      m_step(select_step())
+    {
+      std::copy(p_states, p_states + M, m_states);
+    }
+
+    bool Matches(size_type p_n,
+                 size_type p_m,
+                 const size_type * p_states,
+                 KalmanModel p_model) const noexcept override
+    {
+      return (N == p_n) && (M == p_m) && (m_model == p_model)
+        && std::equal(m_states, m_states + M, p_states);
+    }
+
+    size_type Add(const value_type * p_r) override
+    {
+      const size_type lane = m_lanes;
+      const size_type idx = lane % g_block_lanes;
+
+      if(0 == idx)
+      {
+        // Lanes not yet added are stepped with the block, so give them
+        // a finite gain (0 / (p + r)) rather than 0 / 0.
+        auto & new_block = m_blocks.emplace_back();
+        for(size_type block_lane = 0; block_lane < g_block_lanes; ++block_lane)
+        {
+          for(size_type input = 0; input < M; ++input)
+          {
+            new_block.r[input][block_lane] = 1.0;
+          }
+
+          for(size_type state = 0; state < N; ++state)
+          {
+            new_block.p[state][state][block_lane] = 1.0;
+          }
+        }
+        m_block_triggered.emplace_back(false);
+      }
+
+      auto & block = m_blocks.back();
+      for(size_type input = 0; input < M; ++input)
+      {
+        block.r[input][idx] = p_r[input];
+      }
+
+      for(size_type state = 0; state < N; ++state)
+      {
+        block.p[state][state][idx] = 1.0;
+      }
+
+      ++m_lanes;
+
+      return lane;
+    }
+
+    void Observe(size_type p_lane,
+                 size_type p_input,
+                 value_type p_z) noexcept override
+    {
+      auto & block = m_blocks[p_lane / g_block_lanes];
+      const size_type idx = p_lane % g_block_lanes;
+
+      block.z[p_input][idx] = p_z;
+      block.observed[p_input][idx] = 1.0;
+    }
+
+    void Trigger(size_type p_lane,
+                 value_type p_steps) noexcept override
+    {
+      const size_type block_idx = p_lane / g_block_lanes;
+
+      m_blocks[block_idx].steps[p_lane % g_block_lanes] = p_steps;
+
+      if(!m_block_triggered[block_idx])
+      {
+        m_block_triggered[block_idx] = true;
+        m_triggered.emplace_back(block_idx);
+      }
+    }
+
+    void Step() noexcept override
+    {
+      // Blocks are stepped in runs of consecutive triggered blocks.
+      std::sort(m_triggered.begin(), m_triggered.end());
+
+      size_type first = 0;
+      while(first < m_triggered.size())
+      {
+        size_type last = first + 1;
+        while((last < m_triggered.size()) && (m_triggered[last] == (m_triggered[last - 1] + 1)))
+        {
+          ++last;
+        }
+
+        m_step(m_blocks.data() + m_triggered[first],
+               last - first,
+               m_process_noise,
+               KalmanModel::ConstantVelocity == m_model,
+               m_states);
+        first = last;
+      }
+
+      for(const auto block_idx : m_triggered)
+      {
+        m_block_triggered[block_idx] = false;
+      }
+      m_triggered.clear(yy_data::ClearAction::Keep);
+    }
+
+    value_type X(size_type p_lane,
+                 size_type p_state) const noexcept override
+    {
+      return m_blocks[p_lane / g_block_lanes].x[p_state][p_lane % g_block_lanes];
+    }
+
+  private:
+    static step_type select_step() noexcept
+    {
+#if defined(__x86_64__) || defined(_M_X64)
+      if(__builtin_cpu_supports("avx2"))
+      {
+        return &kalman_batch_detail::step_blocks_avx2<N, M>;
+      }
+#endif
+
+#if defined(__SSE2__)
+      return &kalman_batch_detail::step_blocks<kalman_batch_detail::Sse2Ops, N, M>;
+#else
+      return &kalman_batch_detail::step_blocks<kalman_batch_detail::ScalarOps, N, M>;
+#endif
+    }
+
+    std::vector<block_type> m_blocks{};
+    std::vector<bool> m_block_triggered{};
+    yy_quad::simple_vector<size_type> m_triggered{};
+    size_type m_states[M]{};
+    size_type m_lanes = 0;
+    value_type m_process_noise = 0.0;
+    KalmanModel m_model = KalmanModel::RandomWalk;
+    step_type m_step = nullptr;
+};
+
+template<size_type N, size_type... Ms>
+KalmanBatchPtr make_kalman_batch_n(size_type p_m,
+                                   const size_type * p_states,
+                                   KalmanBatch::value_type p_process_noise,
+                                   KalmanModel p_model,
+                                   std::index_sequence<Ms...> /* inputs */)
+{
+  KalmanBatchPtr batch{};
+
+  std::ignore = ((((Ms + 1) == p_m)
+                  && (batch = std::make_unique<KalmanBatchNM<N, Ms + 1>>(p_states, p_process_noise, p_model), true))
+                 || ...);
+
+  return batch;
+}
+
+template<size_type... Ns>
+KalmanBatchPtr make_kalman_batch(size_type p_n,
+                                 size_type p_m,
+                                 const size_type * p_states,
+                                 KalmanBatch::value_type p_process_noise,
+                                 KalmanModel p_model,
+                                 std::index_sequence<Ns...> /* states */)
+{
+  KalmanBatchPtr batch{};
+
+  std::ignore = ((((Ns + 1) == p_n)
+                  && (batch = make_kalman_batch_n<Ns + 1>(p_m,
+                                                          p_states,
+                                                          p_process_noise,
+                                                          p_model,
+                                                          std::make_index_sequence<g_kalman_fixed_max_inputs>{}), true))
+                 || ...);
+
+  return batch;
+}
+
+} // anonymous namespace
+
+KalmanBatches::Lane KalmanBatches::Add(size_type p_n,
+                                       size_type p_m,
+                                       const size_type * p_states,
+                                       const value_type * p_r,
+                                       value_type p_process_noise,
+                                       KalmanModel p_model)
+{
+  auto batch_iter = std::find_if(m_batches.begin(), m_batches.end(), [p_n, p_m, p_states, p_model](const KalmanBatchPtr & p_batch) {
+    return p_batch->Matches(p_n, p_m, p_states, p_model);
+  });
+
+  if(m_batches.end() == batch_iter)
+  {
+    auto batch{make_kalman_batch(p_n,
+                                 p_m,
+                                 p_states,
+                                 p_process_noise,
+                                 p_model,
+                                 std::make_index_sequence<g_kalman_fixed_max_states>{})};
+    if(!batch)
+    {
+      return Lane{};
+    }
+
+    spdlog::info("    new kalman batch [{}x{}]"sv, p_n, p_m);
+    m_batches.emplace_back(std::move(batch));
+    batch_iter = m_batches.end() - 1;
+  }
+
+  KalmanBatchObsPtr batch{batch_iter->get()};
+
+  return Lane{batch, batch->Add(p_r)};
+}
+
+void KalmanBatches::Pending(ActionObsPtr p_action)
+{
+  m_pending.emplace_back(p_action);
+}
+
+void KalmanBatches::Run(ActionResultVector & p_results,
+                        values::Store & p_values_store,
+                        timestamp_type p_timestamp) noexcept
+{
+  if(m_pending.empty())
+  {
+    return;
+  }
+
+  for(auto & batch : m_batches)
+  {
+    batch->Step();
+  }
+
+  for(auto action : m_pending)
+  {
+    action->Finish(p_results, p_values_store, p_timestamp);
+  }
+
+  m_pending.clear(yy_data::ClearAction::Keep);
+}
+
+} // namespace yafiyogi::actions
@@ -0,0 +1,128 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <memory>
+
+#include "yy_cpp/yy_observer_ptr.hpp"
+#include "yy_cpp/yy_types.hpp"
+#include "yy_cpp/yy_vector.h"
+
+#include "action.hpp"
+#include "action_engine.hpp"
+#include "kalman_model.hpp"
+
+namespace yafiyogi::actions {
+
+// Kalman filters of one shape (model, states, inputs & the state each
+// input observes), each filter a lane. Lanes are stepped together.
+class KalmanBatch
+{
+  public:
+    using value_type = double;
+
+    constexpr KalmanBatch() noexcept = default;
+    KalmanBatch(const KalmanBatch &) = delete;
+    KalmanBatch(KalmanBatch &&) = delete;
+    virtual ~KalmanBatch() noexcept = default;
+
+    KalmanBatch & operator=(const KalmanBatch &) = delete;
+    KalmanBatch & operator=(KalmanBatch &&) = delete;
+
+    [[nodiscard]]
+    virtual bool Matches(size_type p_n,
+                         size_type p_m,
+                         const size_type * p_states,
+                         KalmanModel p_model) const noexcept = 0;
+    // Add a filter with measurement noise p_r. Returns its lane.
+    virtual size_type Add(const value_type * p_r) = 0;
+
+    virtual void Observe(size_type p_lane,
+                         size_type p_input,
+                         value_type p_z) noexcept = 0;
+    // Step the lane p_steps predict intervals on.
+    virtual void Trigger(size_type p_lane,
+                         value_type p_steps) noexcept = 0;
+    // Predict & update the triggered lanes.
+    virtual void Step() noexcept = 0;
+
+    [[nodiscard]]
+    virtual value_type X(size_type p_lane,
+                         size_type p_state) const noexcept = 0;
+};
+
+using KalmanBatchPtr = std::unique_ptr<KalmanBatch>;
+using KalmanBatchObsPtr = yy_data::observer_ptr<KalmanBatch>;
+
+// Engine for Kalman actions in batch mode. Actions observe & trigger
+// their lane in Run(), then publish in Finish() once every batch has
+// been stepped.
+class KalmanBatches final:
+      public Engine
+{
+  public:
+    using value_type = KalmanBatch::value_type;
+
+    struct Lane final
+    {
+        KalmanBatchObsPtr batch{};
+        size_type lane = 0;
+    };
+
+    // Returns a lane without a batch if there isn't a kernel for p_n
+    // states & p_m inputs.
+    [[nodiscard]]
+    Lane Add(size_type p_n,
+             size_type p_m,
+             const size_type * p_states,
+             const value_type * p_r,
+             value_type p_process_noise,
+             KalmanModel p_model);
+
+    void Pending(ActionObsPtr p_action);
+
+    void Run(ActionResultVector & p_results,
+             values::Store & p_values_store,
+             timestamp_type p_timestamp) noexcept override;
+
+    [[nodiscard]]
+    bool empty() const noexcept
+    {
+      return m_batches.empty();
+    }
+
+  private:
+    using batches_type = yy_quad::simple_vector<KalmanBatchPtr>;
+    using pending_type = yy_quad::simple_vector<ActionObsPtr>;
+
+    batches_type m_batches{};
+    pending_type m_pending{};
+};
+
+using KalmanBatchesObsPtr = yy_data::observer_ptr<KalmanBatches>;
+
+} // namespace yafiyogi::actions
@@ -0,0 +1,61 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+// Built with AVX2 enabled (see CMakeLists.txt). Only used when the cpu
+// supports it.
+
+#include "kalman_batch_kernel.hpp"
+
+#if defined(__AVX2__)
+
+namespace yafiyogi::actions::kalman_batch_detail {
+
+template<size_type N, size_type M>
+void step_blocks_avx2(Block<N, M> * p_blocks,
+                      size_type p_count,
+                      double p_process_noise,
+                      bool p_constant_velocity,
+                      const size_type * p_states) noexcept
+{
+  step_blocks<Avx2Ops, N, M>(p_blocks, p_count, p_process_noise, p_constant_velocity, p_states);
+}
+
+template void step_blocks_avx2<1, 1>(Block<1, 1> *, size_type, double, bool, const size_type *) noexcept;
+template void step_blocks_avx2<1, 2>(Block<1, 2> *, size_type, double, bool, const size_type *) noexcept;
+template void step_blocks_avx2<1, 3>(Block<1, 3> *, size_type, double, bool, const size_type *) noexcept;
+template void step_blocks_avx2<1, 4>(Block<1, 4> *, size_type, double, bool, const size_type *) noexcept;
+template void step_blocks_avx2<1, 5>(Block<1, 5> *, size_type, double, bool, const size_type *) noexcept;
+template void step_blocks_avx2<1, 6>(Block<1, 6> *, size_type, double, bool, const size_type *) noexcept;
+template void step_blocks_avx2<2, 1>(Block<2, 1> *, size_type, double, bool, const size_type *) noexcept;
+template void step_blocks_avx2<2, 2>(Block<2, 2> *, size_type, double, bool, const size_type *) noexcept;
+template void step_blocks_avx2<2, 3>(Block<2, 3> *, size_type, double, bool, const size_type *) noexcept;
+template void step_blocks_avx2<2, 4>(Block<2, 4> *, size_type, double, bool, const size_type *) noexcept;
+template void step_blocks_avx2<2, 5>(Block<2, 5> *, size_type, double, bool, const size_type *) noexcept;
+template void step_blocks_avx2<2, 6>(Block<2, 6> *, size_type, double, bool, const size_type *) noexcept;
+
+} // namespace yafiyogi::actions::kalman_batch_detail
+
+#endif
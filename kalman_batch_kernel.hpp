@@ -0,0 +1,215 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#if defined(__SSE2__)
+#include <immintrin.h>
+#endif
+
+#include "yy_cpp/yy_types.hpp"
+
+namespace yafiyogi::actions::kalman_batch_detail {
+
+// Lanes (filters) per block. One AVX2 register of doubles.
+inline constexpr size_type g_block_lanes = 4;
+
+// The state of g_block_lanes filters with N states & M inputs, each
+// variable stored lane by lane (structure of arrays). Observed is 1.0
+// or 0.0 so it can be used as a multiplier. Steps is the number of
+// predict intervals to predict on, 0.0 if the lane isn't triggered.
+template<size_type N, size_type M>
+struct alignas(32) Block final
+{
+    double x[N][g_block_lanes]{};
+    double p[N][N][g_block_lanes]{};
+    double z[M][g_block_lanes]{};
+    double r[M][g_block_lanes]{};
+    double observed[M][g_block_lanes]{};
+    double steps[g_block_lanes]{};
+};
+
+struct ScalarOps final
+{
+    using reg = double;
+    static constexpr size_type width = 1;
+
+    static reg load(const double * p_src) noexcept { return *p_src; }
+    static void store(double * p_dst, reg p_value) noexcept { *p_dst = p_value; }
+    static reg set1(double p_value) noexcept { return p_value; }
+    static reg add(reg p_a, reg p_b) noexcept { return p_a + p_b; }
+    static reg sub(reg p_a, reg p_b) noexcept { return p_a - p_b; }
+    static reg mul(reg p_a, reg p_b) noexcept { return p_a * p_b; }
+    static reg div(reg p_a, reg p_b) noexcept { return p_a / p_b; }
+};
+
+#if defined(__SSE2__)
+struct Sse2Ops final
+{
+    using reg = __m128d;
+    static constexpr size_type width = 2;
+
+    static reg load(const double * p_src) noexcept { return _mm_load_pd(p_src); }
+    static void store(double * p_dst, reg p_value) noexcept { _mm_store_pd(p_dst, p_value); }
+    static reg set1(double p_value) noexcept { return _mm_set1_pd(p_value); }
+    static reg add(reg p_a, reg p_b) noexcept { return _mm_add_pd(p_a, p_b); }
+    static reg sub(reg p_a, reg p_b) noexcept { return _mm_sub_pd(p_a, p_b); }
+    static reg mul(reg p_a, reg p_b) noexcept { return _mm_mul_pd(p_a, p_b); }
+    static reg div(reg p_a, reg p_b) noexcept { return _mm_div_pd(p_a, p_b); }
+};
+#endif
+
+#if defined(__AVX2__)
+struct Avx2Ops final
+{
+    using reg = __m256d;
+    static constexpr size_type width = 4;
+
+    static reg load(const double * p_src) noexcept { return _mm256_load_pd(p_src); }
+    static void store(double * p_dst, reg p_value) noexcept { _mm256_store_pd(p_dst, p_value); }
+    static reg set1(double p_value) noexcept { return _mm256_set1_pd(p_value); }
+    static reg add(reg p_a, reg p_b) noexcept { return _mm256_add_pd(p_a, p_b); }
+    static reg sub(reg p_a, reg p_b) noexcept { return _mm256_sub_pd(p_a, p_b); }
+    static reg mul(reg p_a, reg p_b) noexcept { return _mm256_mul_pd(p_a, p_b); }
+    static reg div(reg p_a, reg p_b) noexcept { return _mm256_div_pd(p_a, p_b); }
+};
+#endif
+
+// Predict & update every triggered lane of p_count blocks, one lane per
+// SIMD element. Observations are applied one input at a time (see
+// KalmanFixed); lanes without an observation get a zero gain, &
+// untriggered lanes predict zero steps. Clears observed & steps.
+template<typename Ops, size_type N, size_type M>
+void step_blocks(Block<N, M> * p_blocks,
+                 size_type p_count,
+                 double p_process_noise,
+                 bool p_constant_velocity,
+                 const size_type * p_states) noexcept
+{
+  using reg = typename Ops::reg;
+  constexpr size_type width = Ops::width;
+
+  const reg zero = Ops::set1(0.0);
+  const reg process_noise = Ops::set1(p_process_noise);
+  const reg half = Ops::set1(0.5);
+  const reg third = Ops::set1(1.0 / 3.0);
+
+  for(size_type block_idx = 0; block_idx < p_count; ++block_idx)
+  {
+    auto & block = p_blocks[block_idx];
+
+    for(size_type lane = 0; lane < g_block_lanes; lane += width)
+    {
+      const reg steps = Ops::load(&block.steps[lane]);
+      const reg q = Ops::mul(process_noise, steps);
+
+      if(p_constant_velocity)
+      {
+        // See kalman_process_noise().
+        const reg q_vr = Ops::mul(Ops::mul(q, steps), half);
+        const reg q_vv = Ops::mul(Ops::mul(Ops::mul(q, steps), steps), third);
+
+        for(size_type value = 0; value + 1 < N; value += 2)
+        {
+          const size_type rate = value + 1;
+
+          Ops::store(&block.x[value][lane],
+                     Ops::add(Ops::load(&block.x[value][lane]), Ops::mul(steps, Ops::load(&block.x[rate][lane]))));
+
+          for(size_type col = 0; col < N; ++col)
+          {
+            Ops::store(&block.p[value][col][lane],
+                       Ops::add(Ops::load(&block.p[value][col][lane]), Ops::mul(steps, Ops::load(&block.p[rate][col][lane]))));
+          }
+
+          for(size_type row = 0; row < N; ++row)
+          {
+            Ops::store(&block.p[row][value][lane],
+                       Ops::add(Ops::load(&block.p[row][value][lane]), Ops::mul(steps, Ops::load(&block.p[row][rate][lane]))));
+          }
+
+          Ops::store(&block.p[value][value][lane], Ops::add(Ops::load(&block.p[value][value][lane]), q_vv));
+          Ops::store(&block.p[value][rate][lane], Ops::add(Ops::load(&block.p[value][rate][lane]), q_vr));
+          Ops::store(&block.p[rate][value][lane], Ops::add(Ops::load(&block.p[rate][value][lane]), q_vr));
+          Ops::store(&block.p[rate][rate][lane], Ops::add(Ops::load(&block.p[rate][rate][lane]), q));
+        }
+      }
+      else
+      {
+        for(size_type idx = 0; idx < N; ++idx)
+        {
+          Ops::store(&block.p[idx][idx][lane], Ops::add(Ops::load(&block.p[idx][idx][lane]), q));
+        }
+      }
+
+      for(size_type input = 0; input < M; ++input)
+      {
+        const size_type state = p_states[input];
+        const reg s = Ops::add(Ops::load(&block.p[state][state][lane]),
+                               Ops::load(&block.r[input][lane]));
+        const reg gain = Ops::div(Ops::load(&block.observed[input][lane]), s);
+        const reg innovation = Ops::sub(Ops::load(&block.z[input][lane]),
+                                        Ops::load(&block.x[state][lane]));
+
+        reg k[N];
+        reg state_row[N];
+
+        for(size_type idx = 0; idx < N; ++idx)
+        {
+          k[idx] = Ops::mul(Ops::load(&block.p[idx][state][lane]), gain);
+          state_row[idx] = Ops::load(&block.p[state][idx][lane]);
+          Ops::store(&block.x[idx][lane],
+                     Ops::add(Ops::load(&block.x[idx][lane]), Ops::mul(k[idx], innovation)));
+        }
+
+        for(size_type row = 0; row < N; ++row)
+        {
+          for(size_type col = 0; col < N; ++col)
+          {
+            Ops::store(&block.p[row][col][lane],
+                       Ops::sub(Ops::load(&block.p[row][col][lane]), Ops::mul(k[row], state_row[col])));
+          }
+        }
+
+        Ops::store(&block.observed[input][lane], zero);
+      }
+
+      Ops::store(&block.steps[lane], zero);
+    }
+  }
+}
+
+#if defined(__x86_64__) || defined(_M_X64)
+// Defined in kalman_batch_avx2.cpp, which is built with AVX2 enabled.
+template<size_type N, size_type M>
+void step_blocks_avx2(Block<N, M> * p_blocks,
+                      size_type p_count,
+                      double p_process_noise,
+                      bool p_constant_velocity,
+                      const size_type * p_states) noexcept;
+#endif
+
+} // namespace yafiyogi::actions::kalman_batch_detail
@@ -0,0 +1,93 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <tuple>
+#include <utility>
+
+#include "kalman_fixed.hpp"
+
+namespace yafiyogi::actions {
+namespace {
+
+template<size_type N, size_type... Ms>
+KalmanKernelPtr make_kalman_fixed_n(size_type p_m,
+                                    const size_type * p_states,
+                                    const KalmanKernel::value_type * p_r,
+                                    KalmanKernel::value_type p_process_noise,
+                                    KalmanModel p_model,
+                                    std::index_sequence<Ms...> /* inputs */)
+{
+  KalmanKernelPtr kernel{};
+
+  std::ignore = ((((Ms + 1) == p_m)
+                  && (kernel = std::make_unique<KalmanFixed<N, Ms + 1>>(p_states, p_r, p_process_noise, p_model), true))
+                 || ...);
+
+  return kernel;
+}
+
+template<size_type... Ns>
+KalmanKernelPtr make_kalman_fixed_nm(size_type p_n,
+                                     size_type p_m,
+                                     const size_type * p_states,
+                                     const KalmanKernel::value_type * p_r,
+                                     KalmanKernel::value_type p_process_noise,
+                                     KalmanModel p_model,
+                                     std::index_sequence<Ns...> /* states */)
+{
+  KalmanKernelPtr kernel{};
+
+  std::ignore = ((((Ns + 1) == p_n)
+                  && (kernel = make_kalman_fixed_n<Ns + 1>(p_m,
+                                                           p_states,
+                                                           p_r,
+                                                           p_process_noise,
+                                                           p_model,
+                                                           std::make_index_sequence<g_kalman_fixed_max_inputs>{}), true))
+                 || ...);
+
+  return kernel;
+}
+
+} // anonymous namespace
+
+KalmanKernelPtr make_kalman_fixed(size_type p_n,
+                                  size_type p_m,
+                                  const size_type * p_states,
+                                  const KalmanKernel::value_type * p_r,
+                                  KalmanKernel::value_type p_process_noise,
+                                  KalmanModel p_model)
+{
+  return make_kalman_fixed_nm(p_n,
+                              p_m,
+                              p_states,
+                              p_r,
+                              p_process_noise,
+                              p_model,
+                              std::make_index_sequence<g_kalman_fixed_max_states>{});
+}
+
+} // namespace yafiyogi::actions
@@ -0,0 +1,212 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <array>
+#include <memory>
+
+#include "yy_cpp/yy_types.hpp"
+
+#include "kalman_model.hpp"
+
+namespace yafiyogi::actions {
+
+// A Kalman filter kernel. Observations are collected with Observe() &
+// applied by Step().
+class KalmanKernel
+{
+  public:
+    using value_type = double;
+
+    constexpr KalmanKernel() noexcept = default;
+    KalmanKernel(const KalmanKernel &) = delete;
+    KalmanKernel(KalmanKernel &&) = delete;
+    virtual ~KalmanKernel() noexcept = default;
+
+    KalmanKernel & operator=(const KalmanKernel &) = delete;
+    KalmanKernel & operator=(KalmanKernel &&) = delete;
+
+    virtual void Observe(size_type p_input,
+                         value_type p_z) noexcept = 0;
+    // Predict p_steps predict intervals on, then update with the
+    // observations since the last step.
+    virtual void Step(value_type p_steps) noexcept = 0;
+    [[nodiscard]]
+    virtual value_type X(size_type p_state) const noexcept = 0;
+};
+
+using KalmanKernelPtr = std::unique_ptr<KalmanKernel>;
+
+// Kernel with N states & M inputs, each input observing one state with
+// independent noise. Storage is inline & the loops have fixed bounds.
+// With diagonal measurement noise, applying the observations one at a
+// time gives the same result as one update of all of them, without an
+// M x M inverse.
+template<size_type N, size_type M>
+class KalmanFixed final:
+      public KalmanKernel
+{
+  public:
+    KalmanFixed(const size_type * p_states,
+                const value_type * p_r,
+                value_type p_process_noise,
+                KalmanModel p_model) noexcept:
+      m_process_noise(p_process_noise),
+      m_model(p_model)
+    {
+      for(size_type input = 0; input < M; ++input)
+      {
+        m_states[input] = p_states[input];
+        m_r[input] = p_r[input];
+      }
+
+      for(size_type idx = 0; idx < N; ++idx)
+      {
+        m_p[idx][idx] = 1.0;
+      }
+    }
+
+    void Observe(size_type p_input,
+                 value_type p_z) noexcept override
+    {
+      m_z[p_input] = p_z;
+      m_observed[p_input] = true;
+    }
+
+    void Step(value_type p_steps) noexcept override
+    {
+      Predict(p_steps);
+
+      for(size_type input = 0; input < M; ++input)
+      {
+        if(m_observed[input])
+        {
+          Update(m_states[input], m_z[input], m_r[input]);
+          m_observed[input] = false;
+        }
+      }
+    }
+
+    [[nodiscard]]
+    value_type X(size_type p_state) const noexcept override
+    {
+      return m_x[p_state];
+    }
+
+  private:
+    void Predict(value_type p_steps) noexcept
+    {
+      const auto q{kalman_process_noise(m_model, m_process_noise, p_steps)};
+
+      if(KalmanModel::ConstantVelocity == m_model)
+      {
+        // Value & rate pairs: x = F x; P = F P F' + Q, F = [1 steps; 0 1].
+        for(size_type value = 0; value + 1 < N; value += 2)
+        {
+          const size_type rate = value + 1;
+
+          m_x[value] += p_steps * m_x[rate];
+
+          for(size_type col = 0; col < N; ++col)
+          {
+            m_p[value][col] += p_steps * m_p[rate][col];
+          }
+
+          for(size_type row = 0; row < N; ++row)
+          {
+            m_p[row][value] += p_steps * m_p[row][rate];
+          }
+
+          m_p[value][value] += q.q_vv;
+          m_p[value][rate] += q.q_vr;
+          m_p[rate][value] += q.q_vr;
+          m_p[rate][rate] += q.q_rr;
+        }
+
+        return;
+      }
+
+      for(size_type idx = 0; idx < N; ++idx)
+      {
+        m_p[idx][idx] += q.q_vv;
+      }
+    }
+
+    void Update(size_type p_state,
+                value_type p_z,
+                value_type p_r) noexcept
+    {
+      const value_type s = m_p[p_state][p_state] + p_r;
+
+      if(s <= 0.0)
+      {
+        return;
+      }
+
+      std::array<value_type, N> k{};
+      std::array<value_type, N> state_row = m_p[p_state];
+      const value_type innovation = p_z - m_x[p_state];
+
+      for(size_type idx = 0; idx < N; ++idx)
+      {
+        k[idx] = m_p[idx][p_state] / s;
+        m_x[idx] += k[idx] * innovation;
+      }
+
+      for(size_type row = 0; row < N; ++row)
+      {
+        for(size_type col = 0; col < N; ++col)
+        {
+          m_p[row][col] -= k[row] * state_row[col];
+        }
+      }
+    }
+
+    std::array<value_type, N> m_x{};
+    std::array<std::array<value_type, N>, N> m_p{};
+    std::array<value_type, M> m_z{};
+    std::array<value_type, M> m_r{};
+    std::array<size_type, M> m_states{};
+    std::array<bool, M> m_observed{};
+    value_type m_process_noise = 0.0;
+    KalmanModel m_model = KalmanModel::RandomWalk;
+};
+
+inline constexpr size_type g_kalman_fixed_max_states = 2;
+inline constexpr size_type g_kalman_fixed_max_inputs = 6;
+
+// Returns an empty pointer if there isn't a kernel for p_n states &
+// p_m inputs.
+[[nodiscard]]
+KalmanKernelPtr make_kalman_fixed(size_type p_n,
+                                  size_type p_m,
+                                  const size_type * p_states,
+                                  const KalmanKernel::value_type * p_r,
+                                  KalmanKernel::value_type p_process_noise,
+                                  KalmanModel p_model);
+
+} // namespace yafiyogi::actions
@@ -0,0 +1,75 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <cstdint>
+
+#include "yy_cpp/yy_types.hpp"
+
+namespace yafiyogi::actions {
+
+// RandomWalk: one state per output, the value. Unchanged by predict.
+// ConstantVelocity: two states per output, the value & its rate of
+//                   change per predict interval. Predict moves the value
+//                   on by the rate.
+enum class KalmanModel:uint8_t {RandomWalk, ConstantVelocity};
+
+[[nodiscard]]
+constexpr size_type kalman_states_per_output(KalmanModel p_model) noexcept
+{
+  return KalmanModel::ConstantVelocity == p_model ? 2 : 1;
+}
+
+// Process noise added by a predict of p_steps intervals, for a value
+// (q_vv), its rate (q_rr) & their covariance (q_vr). Random walk only
+// uses q_vv.
+struct KalmanProcessNoise final
+{
+    double q_vv = 0.0;
+    double q_vr = 0.0;
+    double q_rr = 0.0;
+};
+
+[[nodiscard]]
+constexpr KalmanProcessNoise kalman_process_noise(KalmanModel p_model,
+                                                  double p_process_noise,
+                                                  double p_steps) noexcept
+{
+  if(KalmanModel::ConstantVelocity == p_model)
+  {
+    // Continuous white noise acceleration.
+    const double steps_2 = p_steps * p_steps;
+
+    return KalmanProcessNoise{p_process_noise * steps_2 * p_steps / 3.0,
+                              p_process_noise * steps_2 / 2.0,
+                              p_process_noise * p_steps};
+  }
+
+  return KalmanProcessNoise{p_process_noise * p_steps, 0.0, 0.0};
+}
+
+} // namespace yafiyogi::actions
@@ -0,0 +1,133 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include "kalman_sequential.hpp"
+
+namespace yafiyogi::actions {
+
+KalmanSequential::KalmanSequential(size_type p_states,
+                                   value_type p_process_noise,
+                                   KalmanModel p_model):
+  m_n(p_states),
+  m_process_noise(p_process_noise),
+  m_model(p_model),
+  m_x(p_states, 0.0),
+  m_p(p_states * p_states, 0.0),
+  m_k(p_states, 0.0)
+{
+  for(size_type idx = 0; idx < m_n; ++idx)
+  {
+    m_p[(idx * m_n) + idx] = 1.0;
+  }
+}
+
+void KalmanSequential::Predict(value_type p_steps) noexcept
+{
+  const auto q{kalman_process_noise(m_model, m_process_noise, p_steps)};
+
+  if(KalmanModel::ConstantVelocity == m_model)
+  {
+    // Value & rate pairs: x = F x; P = F P F' + Q, F = [1 steps; 0 1].
+    for(size_type value = 0; value + 1 < m_n; value += 2)
+    {
+      const size_type rate = value + 1;
+
+      m_x[value] += p_steps * m_x[rate];
+
+      for(size_type col = 0; col < m_n; ++col)
+      {
+        m_p[(value * m_n) + col] += p_steps * m_p[(rate * m_n) + col];
+      }
+
+      for(size_type row = 0; row < m_n; ++row)
+      {
+        m_p[(row * m_n) + value] += p_steps * m_p[(row * m_n) + rate];
+      }
+
+      m_p[(value * m_n) + value] += q.q_vv;
+      m_p[(value * m_n) + rate] += q.q_vr;
+      m_p[(rate * m_n) + value] += q.q_vr;
+      m_p[(rate * m_n) + rate] += q.q_rr;
+    }
+
+    return;
+  }
+
+  // x = x; P = P + Q
+  for(size_type idx = 0; idx < m_n; ++idx)
+  {
+    m_p[(idx * m_n) + idx] += q.q_vv;
+  }
+}
+
+void KalmanSequential::Update(size_type p_state,
+                              value_type p_z,
+                              value_type p_r) noexcept
+{
+  // h is a unit row selecting p_state, so
+  // S = P[s][s] + r, K = P[:][s] / S & P = P - K * P[s][:].
+  const value_type * state_row = m_p.data() + (p_state * m_n);
+  const value_type s = state_row[p_state] + p_r;
+
+  if(s <= 0.0)
+  {
+    return;
+  }
+
+  const value_type innovation = p_z - m_x[p_state];
+
+  for(size_type idx = 0; idx < m_n; ++idx)
+  {
+    m_k[idx] = m_p[(idx * m_n) + p_state] / s;
+  }
+
+  for(size_type idx = 0; idx < m_n; ++idx)
+  {
+    m_x[idx] += m_k[idx] * innovation;
+  }
+
+  // The state row is updated last, as the other rows are updated from it.
+  for(size_type row = 0; row < m_n; ++row)
+  {
+    if(row != p_state)
+    {
+      value_type * dst = m_p.data() + (row * m_n);
+      for(size_type col = 0; col < m_n; ++col)
+      {
+        dst[col] -= m_k[row] * state_row[col];
+      }
+    }
+  }
+
+  const value_type k_s = m_k[p_state];
+  value_type * dst = m_p.data() + (p_state * m_n);
+  for(size_type col = 0; col < m_n; ++col)
+  {
+    dst[col] -= k_s * dst[col];
+  }
+}
+
+} // namespace yafiyogi::actions
@@ -0,0 +1,92 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <vector>
+
+#include "yy_cpp/yy_types.hpp"
+
+#include "kalman_model.hpp"
+
+namespace yafiyogi::actions {
+
+// Kalman filter for inputs that each observe one state with independent
+// (diagonal) noise. Each observation is applied as a scalar update, so
+// there is no matrix inverse & an update only touches the observed
+// inputs. Predict follows the KalmanModel over p_steps predict
+// intervals.
+class KalmanSequential final
+{
+  public:
+    using value_type = double;
+    using vector = std::vector<value_type>;
+
+    KalmanSequential() noexcept = default;
+    KalmanSequential(size_type p_states,
+                     value_type p_process_noise,
+                     KalmanModel p_model = KalmanModel::RandomWalk);
+    KalmanSequential(const KalmanSequential &) = default;
+    KalmanSequential(KalmanSequential &&) noexcept = default;
+
+    KalmanSequential & operator=(const KalmanSequential &) = default;
+    KalmanSequential & operator=(KalmanSequential &&) noexcept = default;
+
+    void Predict(value_type p_steps) noexcept;
+
+    // Observation p_z of state p_state with noise variance p_r.
+    void Update(size_type p_state,
+                value_type p_z,
+                value_type p_r) noexcept;
+
+    [[nodiscard]]
+    value_type X(size_type p_state) const noexcept
+    {
+      return m_x[p_state];
+    }
+
+    [[nodiscard]]
+    const vector & X() const noexcept
+    {
+      return m_x;
+    }
+
+    [[nodiscard]]
+    size_type N() const noexcept
+    {
+      return m_n;
+    }
+
+  private:
+    size_type m_n = 0;
+    value_type m_process_noise = 0.0;
+    KalmanModel m_model = KalmanModel::RandomWalk;
+    vector m_x{};
+    vector m_p{}; // Row major n x n covariance.
+    vector m_k{}; // Gain, reused between updates.
+};
+
+} // namespace yafiyogi::actions
@@ -29,6 +29,7 @@
 #include <unistd.h>
 #include <csignal>
 
+#include <algorithm>
 #include <exception>
 #include <memory>
 
@@ -40,9 +41,12 @@
 
 #include "yy_cpp/yy_lockable_value.h"
 #include "yy_cpp/yy_locale.h"
+#include "yy_cpp/yy_vector.h"
 #include "yy_cpp/yy_yaml_util.h"
 #include "yy_values/yy_configure_values.hpp"
 
+#include "action_scheduler.hpp"
+#include "action_timer_queue.hpp"
 #include "actions_result_queue.hpp"
 #include "actions_handler.hpp"
 #include "cache_handler.hpp"
@@ -53,16 +57,25 @@
 #include "logger.h"
 #include "mqtt_client.h"
 #include "mqtt_handler.h"
+#include "mqtt_message.h"
+#include "mqtt_parser.h"
 #include "mqtt_publisher.hpp"
+#include "queue_doorbell.hpp"
+#include "values_metric_data_lanes.hpp"
+#include "values_store_cache.hpp"
 
 namespace yafiyogi {
 namespace {
 
 using ClientPtr = std::shared_ptr<mendel::mqtt_client>;
+using Clients = yy_quad::simple_vector<ClientPtr>;
+using ClientConfigs = yy_quad::simple_vector<mendel::mqtt_client_config>;
+using Parsers = yy_quad::simple_vector<mendel::MqttParserPtr>;
+using Threads = yy_quad::simple_vector<std::jthread>;
 
 struct MendelState
 {
-    ClientPtr client{};
+    Clients clients{};
     bool exit_program = false;
 };
 
@@ -76,9 +89,9 @@ LockableMendelState g_mendel_state;
 auto do_exit_program = [](auto & p_mendel_state) {
   p_mendel_state.exit_program = true;
 
-  if(p_mendel_state.client)
+  for(auto & client : p_mendel_state.clients)
   {
-    p_mendel_state.client->stop();
+    client->stop();
   }
 };
 
@@ -134,14 +147,19 @@ int main(int argc, char* argv[])
 
   const YAML::Node & yaml_config = YAML::LoadFile(config_file);
 
-  if(0 == vm.count("log"))
+  size_type action_workers = 1;
+  size_type store_cache_size = values::StoreCache::default_capacity;
+  if(const auto & yaml_mendel = yaml_config["mendel"sv];
+     yaml_mendel)
   {
-    if(const auto & yaml_mendel = yaml_config["mendel"sv];
-       yaml_mendel)
+    if(0 == vm.count("log"))
     {
       log_config = mendel::configure_logging(yaml_mendel["logging"sv],
                                              log_config);
     }
+
+    action_workers = static_cast<size_type>(std::max(1, yy_util::yaml_get_value(yaml_mendel["action_workers"sv], 1)));
+    store_cache_size = static_cast<size_type>(std::max(1, yy_util::yaml_get_value(yaml_mendel["store_cache_size"sv], static_cast<int>(store_cache_size))));
   }
 
   mendel::set_logger(log_config.filename);
@@ -156,8 +174,6 @@ int main(int argc, char* argv[])
     return 1;
   }
 
-  auto values_config{yy_values::configure_values(yaml_values)};
-
   const auto & yaml_mqtt = yaml_config["mqtt"sv];
   if(!yaml_mqtt)
   {
@@ -168,8 +184,27 @@ int main(int argc, char* argv[])
 
   spdlog::info(" Configure client:"sv);
   auto mqtt_config{mendel::configure_mqtt(yaml_mqtt)};
-  auto mqtt_client_config{mendel::configure_mqtt_client(yaml_mqtt,
-                                                        values_config)};
+
+  // Handlers hold parser state, so each parser gets its own set
+  // configured from a fresh copy of the values. Client 'n' uses the
+  // subscriptions of parser config 'n * parser_count'.
+  ClientConfigs parser_configs{};
+  {
+    auto values_config{yy_values::configure_values(yaml_values)};
+    parser_configs.emplace_back(mendel::configure_mqtt_client(yaml_mqtt,
+                                                              values_config));
+  }
+
+  const size_type client_count = parser_configs[0].client_count;
+  const size_type parser_count = parser_configs[0].parser_count;
+  parser_configs.reserve(client_count * parser_count);
+  while(parser_configs.size() < (client_count * parser_count))
+  {
+    spdlog::info(" Configure parser [{}]:"sv, parser_configs.size());
+    auto values_config{yy_values::configure_values(yaml_values)};
+    parser_configs.emplace_back(mendel::configure_mqtt_client(yaml_mqtt,
+                                                              values_config));
+  }
 
   spdlog::info(" Configure publisher:"sv);
   auto mqtt_publisher_config{mqtt_config};
@@ -198,6 +233,7 @@ int main(int argc, char* argv[])
     values_store = values_builder.Create();
   }
 
+  spdlog::info(" Action workers: [{}]"sv, action_workers);
   spdlog::info(" Mendel ready."sv);
 
   if(!no_run)
@@ -211,44 +247,126 @@ int main(int argc, char* argv[])
       mqtt_publisher->run(p_stop_token);
     }};
 
+    // Action Scheduler
+    // The actions handler sleeps until the cache or the scheduler rings.
+    auto actions_doorbell{std::make_shared<mendel::QueueDoorbell>()};
+    auto action_timer_queue = std::make_shared<actions::ActionTimerQueue>();
+    auto action_scheduler{std::make_shared<mendel::ActionScheduler>(*actions_store,
+                                                                    actions::ActionTimerQueueWriter{action_timer_queue},
+                                                                    actions_doorbell)};
+
     // Actions Handler
     auto action_queue = std::make_shared<values::MetricDataQueue>();
     auto actions_handler{std::make_shared<mendel::ActionsHandler>(std::move(actions_store),
                                                                   values_store,
                                                                   values::MetricDataQueueReader{action_queue},
-                                                                  actions::ActionResultQueueWriter{actions_results_queue})};
+                                                                  actions::ActionTimerQueueReader{action_timer_queue},
+                                                                  actions_doorbell,
+                                                                  actions::ActionResultQueueWriter{actions_results_queue},
+                                                                  action_workers)};
     std::jthread actions_thread{[&actions_handler](std::stop_token p_stop_token) {
       actions_handler->Run(p_stop_token);
     }};
 
+    std::jthread scheduler_thread{};
+    if(!action_scheduler->empty())
+    {
+      scheduler_thread = std::jthread{[&action_scheduler](std::stop_token p_stop_token) {
+        action_scheduler->Run(p_stop_token);
+      }};
+    }
+
     // Cache Handler
-    auto cache_queue = std::make_shared<values::MetricDataQueue>();
+    values::MetricDataLanes cache_lanes{parser_configs.size()};
+    auto cache_writers{cache_lanes.Writers()};
     auto cache_handler{std::make_shared<mendel::CacheHandler>(values_store,
-                                                              values::MetricDataQueueReader{cache_queue},
-                                                              values::MetricDataQueueWriter{action_queue})};
+                                                              std::move(cache_lanes),
+                                                              values::MetricDataLaneWriter{values::MetricDataQueueWriter{action_queue},
+                                                                                           actions_doorbell},
+                                                              store_cache_size)};
     std::jthread cache_thread{[&cache_handler](std::stop_token p_stop_token) {
       cache_handler->Run(p_stop_token);
     }};
 
+    // MQTT Parsers
+    Parsers parsers{};
+    parsers.reserve(parser_configs.size());
+    yy_quad::simple_vector<mendel::MqttMessageQueueWriters> client_parser_queues{};
+    client_parser_queues.reserve(client_count);
+
+    for(size_type client_idx = 0; client_idx < client_count; ++client_idx)
+    {
+      mendel::MqttMessageQueueWriters parser_queues{};
+      parser_queues.reserve(parser_count);
+
+      for(size_type parser_idx = 0; parser_idx < parser_count; ++parser_idx)
+      {
+        const size_type idx = (client_idx * parser_count) + parser_idx;
+        auto parser_queue = std::make_shared<mendel::MqttMessageQueue>();
+
+        parsers.emplace_back(std::make_shared<mendel::MqttParser>(parser_configs[idx],
+                                                                  mendel::MqttMessageQueueReader{parser_queue},
+                                                                  std::move(cache_writers[idx])));
+        parser_queues.emplace_back(mendel::MqttMessageQueueWriter{parser_queue});
+      }
+
+      client_parser_queues.emplace_back(std::move(parser_queues));
+    }
+
+    Threads parser_threads{};
+    parser_threads.reserve(parsers.size());
+    for(auto & parser : parsers)
+    {
+      parser_threads.emplace_back([parser](std::stop_token p_stop_token) {
+        parser->Run(p_stop_token);
+      });
+    }
+
     mosqpp::lib_init();
 
-    ClientPtr client;
-    auto do_create_client = [&client, &mqtt_config, &mqtt_client_config, &cache_queue](auto & p_mendel_state) {
+    Clients clients;
+    auto do_create_clients = [&clients, &mqtt_config, &parser_configs, &client_parser_queues, parser_count](auto & p_mendel_state) {
       if(!p_mendel_state.exit_program)
       {
-        client = std::make_shared<mendel::mqtt_client>(mqtt_config,
-                                                        mqtt_client_config,
-                                                        values::MetricDataQueueWriter{cache_queue});
+        clients.reserve(client_parser_queues.size());
 
-        p_mendel_state.client = client;
+        for(size_type idx = 0; idx < client_parser_queues.size(); ++idx)
+        {
+          // mqtt_client takes ownership of the host name, so each client gets its own copy.
+          auto client_mqtt_config{mqtt_config};
+
+          clients.emplace_back(std::make_shared<mendel::mqtt_client>(client_mqtt_config,
+                                                                     parser_configs[idx * parser_count],
+                                                                     std::move(client_parser_queues[idx])));
+        }
+
+        p_mendel_state.clients = clients;
       }
     };
 
     try
     {
-      LockMendelState::visit(g_mendel_state, do_create_client);
+      LockMendelState::visit(g_mendel_state, do_create_clients);
+
+      // Each client runs on its own thread. A client stopping for any
+      // reason but a signal stops the rest, so they are all joined.
+      Threads client_threads{};
+      client_threads.reserve(clients.size());
 
-      client->run();
+      for(size_type idx = 0; idx < clients.size(); ++idx)
+      {
+        client_threads.emplace_back([client = clients[idx], idx]() {
+          client->run();
+
+          LockMendelState::visit(g_mendel_state, [idx](auto & p_mendel_state) {
+            if(!p_mendel_state.exit_program)
+            {
+              spdlog::error("MQTT client [{}] stopped. Stopping."sv, idx);
+              do_exit_program(p_mendel_state);
+            }
+          });
+        });
+      }
     }
     catch(const std::exception & ex)
     {
@@ -259,10 +377,28 @@ int main(int argc, char* argv[])
       spdlog::critical("Exception caught!"sv);
     }
 
+    for(auto & parser_thread : parser_threads)
+    {
+      parser_thread.request_stop();
+    }
+
+    for(auto & parser_thread : parser_threads)
+    {
+      parser_thread.join();
+    }
+
     cache_thread.request_stop();
     cache_thread.join();
     cache_handler.reset();
 
+    // The scheduler reads the actions store, owned by the actions handler.
+    if(scheduler_thread.joinable())
+    {
+      scheduler_thread.request_stop();
+      scheduler_thread.join();
+    }
+    action_scheduler.reset();
+
     actions_thread.request_stop();
     actions_thread.join();
     actions_handler.reset();
@@ -27,6 +27,8 @@
 #include <cstdint>
 
 #include <chrono>
+#include <functional>
+#include <stdexcept>
 #include <string_view>
 
 #include "spdlog/spdlog.h"
@@ -47,38 +49,85 @@ namespace yafiyogi::mendel {
 
 using namespace std::string_view_literals;
 
+namespace {
+
+void on_connect_callback(struct mosquitto * /* mosq */,
+                         void * obj,
+                         int rc)
+{
+  static_cast<mqtt_client *>(obj)->on_connect(rc);
+}
+
+void on_disconnect_callback(struct mosquitto * /* mosq */,
+                            void * obj,
+                            int rc)
+{
+  static_cast<mqtt_client *>(obj)->on_disconnect(rc);
+}
+
+void on_message_callback(struct mosquitto * /* mosq */,
+                         void * obj,
+                         const struct mosquitto_message * message,
+                         const mosquitto_property * properties)
+{
+  static_cast<mqtt_client *>(obj)->on_message(message, properties);
+}
+
+void on_subscribe_callback(struct mosquitto * /* mosq */,
+                           void * obj,
+                           int mid,
+                           int qos_count,
+                           const int * granted_qos)
+{
+  static_cast<mqtt_client *>(obj)->on_subscribe(mid, qos_count, granted_qos);
+}
+
+} // anonymous namespace
+
 mqtt_client::mqtt_client(mqtt_config & p_config,
                          mqtt_client_config & p_client_config,
-                         values::MetricDataQueueWriter && p_cache_queue):
-  mosqpp::mosquittopp(),
-  m_topics(std::move(p_client_config.topics)),
+                         MqttMessageQueueWriters && p_parser_queues):
+  m_mosq(mosquitto_new(nullptr, true, this)),
   m_subscriptions(std::move(p_client_config.subscriptions)),
   m_host(std::move(p_config.host)),
   m_port(p_config.port),
-  m_cache_queue(std::move(p_cache_queue))
+  m_parser_queues(std::move(p_parser_queues))
 {
-  int mqtt_version = MQTT_PROTOCOL_V5;
-  opts_set(MOSQ_OPT_PROTOCOL_VERSION, &mqtt_version);
+  if(nullptr == m_mosq)
+  {
+    throw std::runtime_error{"mosquitto_new() failed!"};
+  }
 
-  int nodelay_flag = 1;
-  opts_set(MOSQ_OPT_TCP_NODELAY, &nodelay_flag);
+  mosquitto_int_option(m_mosq, MOSQ_OPT_PROTOCOL_VERSION, MQTT_PROTOCOL_V5);
+  mosquitto_int_option(m_mosq, MOSQ_OPT_TCP_NODELAY, 1);
 
-  // int quickack_flag = 1;
-  // opts_set(MOSQ_OPT_TCP_QUICKACK, &quickack_flag);
+  // mosquitto_int_option(m_mosq, MOSQ_OPT_TCP_QUICKACK, 1);
+
+  mosquitto_connect_callback_set(m_mosq, on_connect_callback);
+  mosquitto_disconnect_callback_set(m_mosq, on_disconnect_callback);
+  mosquitto_message_v5_callback_set(m_mosq, on_message_callback);
+  mosquitto_subscribe_callback_set(m_mosq, on_subscribe_callback);
+}
+
+mqtt_client::~mqtt_client() noexcept
+{
+  mosquitto_destroy(m_mosq);
 }
 
 void mqtt_client::run()
 {
-  reconnect_delay_set(2,
-                      default_reconnect_delay_seconds.count(),
-                      false);
-  connect(m_host.c_str(),
-          m_port,
-          std::chrono::duration_cast<std::chrono::seconds>(default_keepalive_seconds).count());
+  mosquitto_reconnect_delay_set(m_mosq,
+                                2,
+                                static_cast<unsigned int>(default_reconnect_delay_seconds.count()),
+                                false);
+  mosquitto_connect(m_mosq,
+                    m_host.c_str(),
+                    m_port,
+                    static_cast<int>(std::chrono::duration_cast<std::chrono::seconds>(default_keepalive_seconds).count()));
 
   try
   {
-    loop_forever();
+    mosquitto_loop_forever(m_mosq, -1, 1);
   }
   catch(const std::exception & ex)
   {
@@ -89,7 +138,7 @@ void mqtt_client::run()
     spdlog::critical("Exception caught!"sv);
   }
 
-  disconnect();
+  mosquitto_disconnect(m_mosq);
 
   while(is_connected())
   {
@@ -99,7 +148,7 @@ void mqtt_client::run()
 
 void mqtt_client::stop()
 {
-  disconnect();
+  mosquitto_disconnect(m_mosq);
 }
 
 void mqtt_client::on_connect(int rc)
@@ -109,22 +158,29 @@ void mqtt_client::on_connect(int rc)
   spdlog::debug("{}[{}]"sv, "MQTT Connected status="sv, rc);
   spdlog::info(" {}"sv, "Subscribing to:"sv);
 
-  yy_quad::simple_vector<char *> subs{};
-  subs.reserve(m_subscriptions.size());
-
-  for(auto & sub : m_subscriptions)
+  // One subscribe per filter, each with its own MQTT v5 subscription
+  // identifier (index + 1) so the broker tells us which filter matched.
+  for(size_type idx = 0; idx < m_subscriptions.size(); ++idx)
   {
-    spdlog::info(" {}[{}]"sv, "\t - "sv, sub);
+    const auto & sub = m_subscriptions[idx];
+    const auto subscription_id = static_cast<std::uint32_t>(idx + 1);
 
-    subs.emplace_back(sub.data());
-  }
+    spdlog::info(" {}[{}] id=[{}]"sv, "\t - "sv, sub, subscription_id);
+
+    mosquitto_property * properties = nullptr;
+    mosquitto_property_add_varint(&properties,
+                                  MQTT_PROP_SUBSCRIPTION_IDENTIFIER,
+                                  subscription_id);
+
+    mosquitto_subscribe_v5(m_mosq,
+                           nullptr,
+                           sub.c_str(),
+                           0,
+                           0,
+                           properties);
 
-  mosqpp::mosquittopp::subscribe_multiple(nullptr,
-                                          static_cast<int>(subs.size()),
-                                          subs.data(),
-                                          0,
-                                          0,
-                                          nullptr);
+    mosquitto_property_free_all(&properties);
+  }
 }
 
 struct ActionData final
@@ -143,37 +199,50 @@ struct ActionData final
     yy_values::MetricDataVector data;
 };
 
-void mqtt_client::on_message(const struct mosquitto_message * message)
+void mqtt_client::on_message(const struct mosquitto_message * message,
+                             const mosquitto_property * properties)
 {
+  // Only copy the message here, parsing is done by the parser threads.
   std::string_view topic{yy_mqtt::topic_trim(message->topic)};
-  if(auto payloads = m_topics.find(topic);
-     !payloads.empty())
-  {
-    spdlog::debug("Client Processing [{}] payloads=[{}]"sv, topic, payloads.size());
-    yy_mqtt::topic_tokenize_view(m_path, topic);
 
-    const std::string_view data{static_cast<std::string_view::value_type *>(message->payload),
-                                static_cast<std::string_view::size_type>(message->payloadlen)};
+  const std::string_view data{static_cast<std::string_view::value_type *>(message->payload),
+                              static_cast<std::string_view::size_type>(message->payloadlen)};
 
-    timestamp_type ts{std::chrono::time_point_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now()).time_since_epoch()};
-
-    size_type metric_count = 0;
-    m_metric_data.clear(yy_data::ClearAction::Keep);
+  // Messages for a topic always go to the same parser to keep them in order.
+  size_type parser_idx = 0;
+  if(m_parser_queues.size() > 1)
+  {
+    parser_idx = std::hash<std::string_view>{}(topic) % m_parser_queues.size();
+  }
 
-    yy_values::MetricDataVectorPtr metric_data{&m_metric_data};
-    for(auto & handlers : payloads)
+  m_message.topic.assign(topic);
+  m_message.payload.assign(data);
+  m_message.timestamp = timestamp_type{std::chrono::time_point_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now()).time_since_epoch()};
+
+  m_message.subscription_id_count = 0;
+  std::uint32_t subscription_id = 0;
+  for(auto property = mosquitto_property_read_varint(properties,
+                                                     MQTT_PROP_SUBSCRIPTION_IDENTIFIER,
+                                                     &subscription_id,
+                                                     false);
+      nullptr != property;
+      property = mosquitto_property_read_varint(property,
+                                                MQTT_PROP_SUBSCRIPTION_IDENTIFIER,
+                                                &subscription_id,
+                                                true))
+  {
+    if(m_message.subscription_id_count == MqttMessage::max_subscription_ids)
     {
-      for(auto & handler : *handlers)
-      {
-        metric_count += handler->MetricCount();
-        m_metric_data.reserve(metric_count);
-
-        handler->Event(data, topic, m_path, ts, metric_data);
-      }
+      // Too many to route by id, fall back to matching the topic.
+      m_message.subscription_id_count = 0;
+      break;
     }
 
-    m_cache_queue.QSwapIn(m_metric_data);
+    m_message.subscription_ids[m_message.subscription_id_count] = subscription_id;
+    ++m_message.subscription_id_count;
   }
+
+  m_parser_queues[parser_idx].QSwapIn(m_message);
 }
 
 bool mqtt_client::is_connected() noexcept
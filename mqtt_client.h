@@ -27,17 +27,16 @@
 #pragma once
 
 #include <atomic>
+#include <chrono>
 #include <memory>
 #include <string>
 #include <string_view>
 
-#include <memory>
-
-#include "mosquitto/libmosquittopp.h"
+#include "mosquitto/mosquitto.h"
 
 #include "yy_values/yy_values_labels.hpp"
 
-#include "values_metric_data_queue.hpp"
+#include "mqtt_message.h"
 #include "mqtt_topics.h"
 
 namespace yafiyogi::mendel {
@@ -46,45 +45,47 @@ class CacheHandler;
 using CacheHandlerPtr = std::shared_ptr<CacheHandler>;
 
 class mqtt_config;
-class mqtt_client_config;
+struct mqtt_client_config;
 
-class mqtt_client final:
-      public mosqpp::mosquittopp
+// Uses the mosquitto C API directly as mosquittopp has no MQTT v5
+// message callback, which is needed to read subscription identifiers.
+class mqtt_client final
 {
   public:
     explicit mqtt_client(mqtt_config & config,
                          mqtt_client_config & p_client_config,
-                         values::MetricDataQueueWriter && p_cache_queue);
+                         MqttMessageQueueWriters && p_parser_queues);
 
     mqtt_client() = delete;
     mqtt_client(const mqtt_client &) = delete;
-    constexpr mqtt_client(mqtt_client &&) noexcept = default;
+    mqtt_client(mqtt_client &&) = delete;
+    ~mqtt_client() noexcept;
 
     mqtt_client & operator=(const mqtt_client &) = delete;
-    constexpr mqtt_client & operator=(mqtt_client &&) noexcept = default;
+    mqtt_client & operator=(mqtt_client &&) = delete;
 
     void run();
     void stop();
     bool is_connected() noexcept;
-    void on_connect(int rc) override;
-    void on_disconnect(int rc) override;
-    void on_message(const struct mosquitto_message * message) override;
+    void on_connect(int rc);
+    void on_disconnect(int rc);
+    void on_message(const struct mosquitto_message * message,
+                    const mosquitto_property * properties);
     void on_subscribe(int mid,
                       int qos_count,
-                      const int * granted_qos) override;
+                      const int * granted_qos);
 
   private:
     static constexpr std::chrono::seconds default_keepalive_seconds{60};
     static constexpr std::chrono::seconds default_reconnect_delay_seconds{15};
     static constexpr std::chrono::milliseconds default_disconnect_sleep{500};
 
-    Topics m_topics{};
+    struct mosquitto * m_mosq = nullptr;
     Subscriptions m_subscriptions{};
     std::string m_host{};
     int m_port = yy_mqtt::mqtt_default_port;
-    yy_mqtt::TopicLevelsView m_path{};
-    yy_values::MetricDataVector m_metric_data{};
-    values::MetricDataQueueWriter m_cache_queue{};
+    MqttMessage m_message{};
+    MqttMessageQueueWriters m_parser_queues{};
     std::atomic<bool> m_is_connected = false;
 };
 
@@ -42,10 +42,12 @@ MqttHandler::MqttHandler(std::string_view p_handler_id,
 MqttHandler::MqttHandler(MqttHandler && p_other) noexcept:
   m_metric_count(p_other.m_metric_count),
   m_handler_id(std::move(p_other.m_handler_id)),
-  m_type(p_other.m_type)
+  m_type(p_other.m_type),
+  m_compression(p_other.m_compression)
 {
   p_other.m_metric_count = 0;
   p_other.m_type = type::Text;
+  p_other.m_compression = compression::None;
 }
 
 MqttHandler & MqttHandler::operator=(MqttHandler && p_other) noexcept
@@ -57,9 +59,26 @@ MqttHandler & MqttHandler::operator=(MqttHandler && p_other) noexcept
     m_handler_id = std::move(p_other.m_handler_id);
     m_type = p_other.m_type;
     p_other.m_type = type::Text;
+    m_compression = p_other.m_compression;
+    p_other.m_compression = compression::None;
   }
   return *this;
 }
 
+void metric_data_set_binary(yy_values::MetricDataVector & p_metric_data,
+                            size_type p_first,
+                            std::string_view p_raw,
+                            double p_binary) noexcept
+{
+  for(size_type idx = p_first; idx < p_metric_data.size(); ++idx)
+  {
+    if(auto & data = p_metric_data[idx];
+       data.Value() == p_raw)
+    {
+      data.Binary(p_binary);
+    }
+  }
+}
+
 
 } // namespace yafiyogi::mendel
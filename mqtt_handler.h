@@ -43,7 +43,8 @@ namespace yafiyogi::mendel {
 class MqttHandler
 {
   public:
-    enum class type:uint8_t {Json, Text, Value};
+    enum class type:uint8_t {Json, Text, Value, Binary, Cbor, Msgpack};
+    enum class compression:uint8_t {None, Deflate, Gzip};
 
     explicit MqttHandler(std::string_view p_handler_id,
                          const type p_type,
@@ -75,6 +76,18 @@ class MqttHandler
       return m_metric_count;
     }
 
+    // Payloads are inflated before Event() is called.
+    [[nodiscard]]
+    constexpr compression Compression() const noexcept
+    {
+      return m_compression;
+    }
+
+    constexpr void Compression(compression p_compression) noexcept
+    {
+      m_compression = p_compression;
+    }
+
     virtual void Event(std::string_view p_mqtt_data,
                        const std::string_view p_topic,
                        const yy_mqtt::TopicLevelsView & p_levels ,
@@ -85,6 +98,14 @@ class MqttHandler
     size_type m_metric_count = 0;
     std::string m_handler_id{};
     type m_type = type::Text;
+    compression m_compression = compression::None;
 };
 
+// Set the binary value of metric data added from 'p_first' onwards
+// whose text value is still 'p_raw' (i.e. not changed by a value action).
+void metric_data_set_binary(yy_values::MetricDataVector & p_metric_data,
+                            size_type p_first,
+                            std::string_view p_raw,
+                            double p_binary) noexcept;
+
 } // namespace yafiyogi::mendel
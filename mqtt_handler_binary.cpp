@@ -0,0 +1,127 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <array>
+#include <charconv>
+#include <cstdint>
+#include <string_view>
+
+#include "spdlog/spdlog.h"
+
+#include "yy_cpp/yy_make_lookup.h"
+
+#include "yy_values/yy_value_type.hpp"
+#include "yy_values/yy_values_metric.hpp"
+#include "yy_values/yy_values_metric_data.hpp"
+
+#include "mqtt_handler_binary.h"
+
+namespace yafiyogi::mendel {
+
+using namespace std::string_view_literals;
+
+namespace binary_handler_detail {
+namespace {
+
+template<std::endian Endian>
+constexpr auto field_types =
+  yy_data::make_lookup<std::string_view, FieldType>(FieldType{},
+                                                    {{"i8"sv, FieldType{&decode<std::int8_t, Endian>, sizeof(std::int8_t), yy_values::ValueType::Int}},
+                                                     {"u8"sv, FieldType{&decode<std::uint8_t, Endian>, sizeof(std::uint8_t), yy_values::ValueType::UInt}},
+                                                     {"i16"sv, FieldType{&decode<std::int16_t, Endian>, sizeof(std::int16_t), yy_values::ValueType::Int}},
+                                                     {"u16"sv, FieldType{&decode<std::uint16_t, Endian>, sizeof(std::uint16_t), yy_values::ValueType::UInt}},
+                                                     {"i32"sv, FieldType{&decode<std::int32_t, Endian>, sizeof(std::int32_t), yy_values::ValueType::Int}},
+                                                     {"u32"sv, FieldType{&decode<std::uint32_t, Endian>, sizeof(std::uint32_t), yy_values::ValueType::UInt}},
+                                                     {"i64"sv, FieldType{&decode<std::int64_t, Endian>, sizeof(std::int64_t), yy_values::ValueType::Int}},
+                                                     {"u64"sv, FieldType{&decode<std::uint64_t, Endian>, sizeof(std::uint64_t), yy_values::ValueType::UInt}},
+                                                     {"f32"sv, FieldType{&decode<float, Endian>, sizeof(float), yy_values::ValueType::Float}},
+                                                     {"f64"sv, FieldType{&decode<double, Endian>, sizeof(double), yy_values::ValueType::Float}}});
+
+} // anonymous namespace
+
+FieldType field_type(std::string_view p_type,
+                     std::endian p_endian) noexcept
+{
+  if(std::endian::big == p_endian)
+  {
+    return field_types<std::endian::big>.lookup(p_type);
+  }
+
+  return field_types<std::endian::little>.lookup(p_type);
+}
+
+} // namespace binary_handler_detail
+
+MqttBinaryHandler::MqttBinaryHandler(std::string_view p_handler_id,
+                                     Fields && p_fields,
+                                     size_type p_length,
+                                     yy_values::Metrics && p_metrics,
+                                     size_type p_metrics_count) noexcept:
+  MqttHandler(p_handler_id, type::Binary, p_metrics_count),
+  m_fields(std::move(p_fields)),
+  m_length(p_length),
+  m_metrics(std::move(p_metrics))
+{
+}
+
+void MqttBinaryHandler::Event(std::string_view p_mqtt_data,
+                              const std::string_view p_topic,
+                              const yy_mqtt::TopicLevelsView & p_levels,
+                              const timestamp_type p_timestamp,
+                              yy_values::MetricDataVectorPtr p_metric_data) noexcept
+{
+  spdlog::debug("  handler [{}]"sv, Id());
+
+  if(p_mqtt_data.size() < m_length)
+  {
+    spdlog::debug("  handler [{}] payload too short [{} < {}]"sv,
+                  Id(),
+                  p_mqtt_data.size(),
+                  m_length);
+    return;
+  }
+
+  binary_handler_detail::ValueBuffer buffer{};
+  for(const auto & [type, offset, metrics] : m_fields)
+  {
+    const auto [value, value_str] = type.decoder(p_mqtt_data.data() + offset, buffer);
+    const size_type first = p_metric_data->size();
+
+    for(auto & metric : metrics)
+    {
+      metric->Event(value_str,
+                    p_topic,
+                    p_levels,
+                    p_timestamp,
+                    type.value_type,
+                    p_metric_data);
+    }
+
+    metric_data_set_binary(*p_metric_data, first, value_str, value);
+  }
+}
+
+} // namespace yafiyogi::mendel
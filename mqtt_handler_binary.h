@@ -0,0 +1,156 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <charconv>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <system_error>
+
+#include "yy_cpp/yy_observer_ptr.hpp"
+#include "yy_cpp/yy_vector.h"
+
+#include "yy_mqtt/yy_mqtt_types.h"
+
+#include "yy_values/yy_value_type.hpp"
+#include "yy_values/yy_values_metric.hpp"
+#include "yy_values/yy_values_metric_data.hpp"
+
+#include "mqtt_handler.h"
+
+namespace yafiyogi::mendel {
+namespace binary_handler_detail {
+
+using Metric = std::pointer_traits<yy_values::Metrics::value_type>::element_type;
+using MetricObsPtr = yy_data::observer_ptr<Metric>;
+using MetricObsPtrs = yy_quad::simple_vector<MetricObsPtr>;
+
+// Text of a decoded value. Metrics take text values.
+using ValueBuffer = std::array<char, 32>;
+
+// A decoded value: the number & its text.
+struct DecodedValue final
+{
+    double binary = 0.0;
+    std::string_view text{};
+};
+
+using decoder_type = DecodedValue (*)(const char *, ValueBuffer &) noexcept;
+
+// Decode a 'T' stored with 'Endian' byte order. 'p_data' need not be
+// aligned. The text is formatted from the 'T', so 64 bit integers keep
+// every digit.
+template<typename T,
+         std::endian Endian>
+DecodedValue decode(const char * p_data,
+                    ValueBuffer & p_buffer) noexcept
+{
+  std::array<char, sizeof(T)> bytes;
+  std::memcpy(bytes.data(), p_data, sizeof(T));
+
+  if constexpr(Endian != std::endian::native)
+  {
+    std::reverse(bytes.begin(), bytes.end());
+  }
+
+  const T value = std::bit_cast<T>(bytes);
+
+  // A float is formatted as a float, the shortest text that reads back
+  // as the same f32 (0.1, not 0.10000000149011612).
+  char * begin = p_buffer.data();
+  const auto result = std::to_chars(begin, begin + p_buffer.size(), value);
+
+  if(std::errc{} != result.ec)
+  {
+    return DecodedValue{static_cast<double>(value), std::string_view{}};
+  }
+
+  return DecodedValue{static_cast<double>(value), std::string_view{begin, result.ptr}};
+}
+
+struct FieldType final
+{
+    decoder_type decoder = nullptr;
+    size_type size = 0;
+    yy_values::ValueType value_type = yy_values::ValueType::Unknown;
+};
+
+// Returns a field type with a null decoder if 'p_type' is unknown.
+FieldType field_type(std::string_view p_type,
+                     std::endian p_endian) noexcept;
+
+// A field of the payload & the metrics it is published to.
+struct Field final
+{
+    FieldType type{};
+    size_type offset = 0;
+    MetricObsPtrs metrics{};
+};
+
+using Fields = yy_quad::simple_vector<Field>;
+
+} // namespace binary_handler_detail
+
+// Decodes fixed layout binary payloads (e.g. packed C structs).
+// Payloads shorter than the layout are ignored.
+class MqttBinaryHandler final:
+      public MqttHandler
+{
+  public:
+    using MetricDataVector = yy_values::MetricDataVector;
+    using Fields = binary_handler_detail::Fields;
+
+    explicit MqttBinaryHandler(std::string_view p_handler_id,
+                               Fields && p_fields,
+                               size_type p_length,
+                               yy_values::Metrics && p_metrics,
+                               size_type p_metrics_count) noexcept;
+
+    MqttBinaryHandler() = delete;
+    MqttBinaryHandler(const MqttBinaryHandler &) = delete;
+    MqttBinaryHandler(MqttBinaryHandler &&) noexcept = default;
+
+    MqttBinaryHandler & operator=(const MqttBinaryHandler &) = delete;
+    MqttBinaryHandler & operator=(MqttBinaryHandler &&) noexcept = default;
+
+    void Event(std::string_view p_mqtt_data,
+               const std::string_view p_topic,
+               const yy_mqtt::TopicLevelsView & p_levels,
+               const timestamp_type p_timestamp,
+               yy_values::MetricDataVectorPtr p_metric_data) noexcept override;
+
+  private:
+    Fields m_fields{};
+    size_type m_length = 0;
+    yy_values::Metrics m_metrics{};
+};
+
+} // namespace yafiyogi::mendel
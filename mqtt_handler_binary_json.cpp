@@ -0,0 +1,78 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <string_view>
+#include <tuple>
+
+#include "spdlog/spdlog.h"
+
+#include "yy_values/yy_values_metric_data.hpp"
+
+#include "mqtt_handler_binary_json.h"
+
+namespace yafiyogi::mendel {
+
+using namespace std::string_view_literals;
+
+template<template<typename> class ReaderType,
+         MqttHandler::type HandlerType>
+MqttBinaryJsonHandler<ReaderType, HandlerType>::MqttBinaryJsonHandler(std::string_view p_handler_id,
+                                                                      handler_config_type && p_json_handler_config,
+                                                                      size_type p_max_depth,
+                                                                      size_type p_pointer_count,
+                                                                      size_type p_metric_count) noexcept:
+  MqttHandler(p_handler_id, HandlerType, p_metric_count),
+  m_handler(std::move(p_json_handler_config)),
+  m_reader(p_max_depth),
+  m_pointer_count(p_pointer_count)
+{
+}
+
+template<template<typename> class ReaderType,
+         MqttHandler::type HandlerType>
+void MqttBinaryJsonHandler<ReaderType, HandlerType>::Event(std::string_view p_mqtt_data,
+                                                           const std::string_view p_topic,
+                                                           const yy_mqtt::TopicLevelsView & p_levels,
+                                                           const timestamp_type p_timestamp,
+                                                           yy_values::MetricDataVectorPtr p_metric_data) noexcept
+{
+  spdlog::debug("  handler [{}]"sv, Id());
+
+  json_handler_detail::prepare_handler(m_handler,
+                                       p_topic,
+                                       p_levels,
+                                       p_timestamp,
+                                       p_metric_data,
+                                       m_pointer_count);
+
+  // Stops early on malformed payloads, or once all pointers are seen.
+  std::ignore = m_reader.read(p_mqtt_data, m_handler);
+}
+
+template class MqttBinaryJsonHandler<CborReader, MqttHandler::type::Cbor>;
+template class MqttBinaryJsonHandler<MsgpackReader, MqttHandler::type::Msgpack>;
+
+} // namespace yafiyogi::mendel
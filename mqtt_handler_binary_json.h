@@ -0,0 +1,89 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <string_view>
+
+#include "yy_json/yy_json_pointer.h"
+#include "yy_mqtt/yy_mqtt_types.h"
+
+#include "yy_values/yy_values_metric.hpp"
+#include "yy_values/yy_values_metric_data.hpp"
+
+#include "binary_json_reader.hpp"
+#include "mqtt_handler.h"
+#include "mqtt_handler_json.h"
+
+namespace yafiyogi::mendel {
+
+// Json pointer handlers for binary encodings of json (CBOR & MessagePack).
+// They're configured like json handlers; 'ReaderType' walks the encoding
+// calling the same json pointer automaton.
+template<template<typename> class ReaderType,
+         MqttHandler::type HandlerType>
+class MqttBinaryJsonHandler final:
+      public MqttHandler
+{
+  public:
+    using MetricDataVector = yy_values::MetricDataVector;
+    using builder_type = MqttJsonHandler::builder_type;
+    using handler_type = builder_type::handler_type;
+    using handler_config_type = handler_type::pointers_config_type;
+    using reader_type = ReaderType<handler_type>;
+
+    explicit MqttBinaryJsonHandler(std::string_view p_handler_id,
+                                   handler_config_type && p_json_handler_config,
+                                   size_type p_max_depth,
+                                   size_type p_pointer_count,
+                                   size_type p_metric_count) noexcept;
+
+    MqttBinaryJsonHandler() = delete;
+    MqttBinaryJsonHandler(const MqttBinaryJsonHandler &) = delete;
+    MqttBinaryJsonHandler(MqttBinaryJsonHandler &&) noexcept = default;
+
+    MqttBinaryJsonHandler & operator=(const MqttBinaryJsonHandler &) = delete;
+    MqttBinaryJsonHandler & operator=(MqttBinaryJsonHandler &&) noexcept = default;
+
+    void Event(std::string_view p_mqtt_data,
+               const std::string_view p_topic,
+               const yy_mqtt::TopicLevelsView & p_levels,
+               const timestamp_type p_timestamp,
+               yy_values::MetricDataVectorPtr p_metric_data) noexcept override;
+
+  private:
+    handler_type m_handler;
+    reader_type m_reader;
+    size_type m_pointer_count = 0;
+};
+
+using MqttCborHandler = MqttBinaryJsonHandler<CborReader, MqttHandler::type::Cbor>;
+using MqttMsgpackHandler = MqttBinaryJsonHandler<MsgpackReader, MqttHandler::type::Msgpack>;
+
+extern template class MqttBinaryJsonHandler<CborReader, MqttHandler::type::Cbor>;
+extern template class MqttBinaryJsonHandler<MsgpackReader, MqttHandler::type::Msgpack>;
+
+} // namespace yafiyogi::mendel
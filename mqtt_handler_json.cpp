@@ -24,6 +24,7 @@
 
 */
 
+#include <algorithm>
 #include <memory>
 #include <string_view>
 
@@ -48,7 +49,9 @@ JsonVisitor::JsonVisitor(JsonVisitor && p_other) noexcept:
   m_levels(std::move(p_other.m_levels)),
   m_metric_data(std::move(p_other.m_metric_data)),
   m_timestamp(p_other.m_timestamp),
-  m_topic(p_other.m_topic)
+  m_topic(p_other.m_topic),
+  m_pointers_seen(std::move(p_other.m_pointers_seen)),
+  m_pointer_count(p_other.m_pointer_count)
 {
   p_other.reset();
 }
@@ -61,6 +64,8 @@ JsonVisitor & JsonVisitor::operator=(JsonVisitor && p_other) noexcept
     m_metric_data = std::move(p_other.m_metric_data);
     m_timestamp = p_other.m_timestamp;
     m_topic = p_other.m_topic;
+    m_pointers_seen = std::move(p_other.m_pointers_seen);
+    m_pointer_count = p_other.m_pointer_count;
 
     p_other.reset();
   }
@@ -92,37 +97,61 @@ void JsonVisitor::timestamp(const timestamp_type p_timestamp) noexcept
   m_timestamp = p_timestamp;
 }
 
+void JsonVisitor::pointer_count(size_type p_pointer_count)
+{
+  m_pointer_count = p_pointer_count;
+  m_pointers_seen.reserve(p_pointer_count);
+}
+
 void JsonVisitor::reset() noexcept
 {
   m_levels = &g_empty_levels;
   m_metric_data.release();
   m_timestamp = timestamp_type{};
   m_topic = std::string_view{};
+  m_pointers_seen.clear(yy_data::ClearAction::Keep);
+  m_pointer_count = 0;
 }
 
-void JsonVisitor::apply(Metrics & p_metrics,
-                        std::string_view p_value,
-                        yy_values::ValueType p_value_type)
+template<typename ParserType>
+void parse(ParserType & p_parser,
+           std::string_view p_mqtt_data,
+           const std::string_view p_topic,
+           const yy_mqtt::TopicLevelsView & p_levels,
+           const timestamp_type p_timestamp,
+           yy_values::MetricDataVectorPtr p_metric_data,
+           size_type p_pointer_count) noexcept
 {
-  for(auto & metric : p_metrics)
-  {
-    metric->Event(p_value,
-                  m_topic,
-                  *m_levels,
-                  m_timestamp,
-                  p_value_type,
-                  m_metric_data);
-  }
+  p_parser.reset();
+  prepare_handler(p_parser.handler(),
+                  p_topic,
+                  p_levels,
+                  p_timestamp,
+                  p_metric_data,
+                  p_pointer_count);
+
+  // The whole payload is written at once so keys, strings & numbers
+  // reach the handler whole. The handler stops the parser once every
+  // json pointer has been seen.
+  boost::json::error_code ec{};
+  p_parser.write_some(false,
+                      p_mqtt_data.data(),
+                      p_mqtt_data.size(),
+                      ec);
 }
 
-}
+} // namespace json_handler_detail
 
 MqttJsonHandler::MqttJsonHandler(std::string_view p_handler_id,
                                  const parser_options_type & p_json_options,
                                  handler_config_type && p_json_handler_config,
+                                 PointerMetrics && p_pointer_metrics,
+                                 size_type p_pointer_count,
                                  size_type p_metric_count) noexcept:
   MqttHandler(p_handler_id, type::Json, p_metric_count),
-  m_parser(p_json_options, std::move(p_json_handler_config))
+  m_parser(p_json_options, std::move(p_json_handler_config)),
+  m_pointer_metrics(std::move(p_pointer_metrics)),
+  m_pointer_count(p_pointer_count)
 {
 }
 
@@ -134,21 +163,41 @@ void MqttJsonHandler::Event(std::string_view p_mqtt_data,
 {
   spdlog::debug("  handler [{}]"sv, Id());
 
-  m_parser.reset();
-  auto & handler = m_parser.handler();
-  handler.reset();
-  auto & visitor = handler.visitor();
+  json_handler_detail::parse(m_parser,
+                             p_mqtt_data,
+                             p_topic,
+                             p_levels,
+                             p_timestamp,
+                             p_metric_data,
+                             m_pointer_count);
+}
 
-  visitor.reset();
-  visitor.levels(&p_levels);
-  visitor.metric_data(p_metric_data);
-  visitor.timestamp(p_timestamp);
-  visitor.topic(p_topic);
+MqttJsonCombinedHandler::MqttJsonCombinedHandler(std::string_view p_handler_id,
+                                                 const parser_options_type & p_json_options,
+                                                 handler_config_type && p_json_handler_config,
+                                                 size_type p_pointer_count,
+                                                 size_type p_metric_count) noexcept:
+  MqttHandler(p_handler_id, type::Json, p_metric_count),
+  m_parser(p_json_options, std::move(p_json_handler_config)),
+  m_pointer_count(p_pointer_count)
+{
+}
 
-  m_parser.write_some(false,
-                      p_mqtt_data.data(),
-                      p_mqtt_data.size(),
-                      boost::json::error_code{});
+void MqttJsonCombinedHandler::Event(std::string_view p_mqtt_data,
+                                    const std::string_view p_topic,
+                                    const yy_mqtt::TopicLevelsView & p_levels,
+                                    const timestamp_type p_timestamp,
+                                    yy_values::MetricDataVectorPtr p_metric_data) noexcept
+{
+  spdlog::debug("  handler [{}]"sv, Id());
+
+  json_handler_detail::parse(m_parser,
+                             p_mqtt_data,
+                             p_topic,
+                             p_levels,
+                             p_timestamp,
+                             p_metric_data,
+                             m_pointer_count);
 }
 
 } // namespace yafiyogi::mendel
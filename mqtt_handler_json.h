@@ -26,9 +26,17 @@
 
 #pragma once
 
+#include <algorithm>
 #include <cstdint>
+#include <memory>
+#include <string>
+#include <string_view>
 
 #include "boost/json/basic_parser_impl.hpp"
+#include "boost/system/errc.hpp"
+
+#include "yy_cpp/yy_observer_ptr.hpp"
+#include "yy_cpp/yy_vector.h"
 
 #include "yy_json/yy_json_pointer.h"
 #include "yy_mqtt/yy_mqtt_types.h"
@@ -42,62 +50,129 @@
 namespace yafiyogi::mendel {
 namespace json_handler_detail {
 
+using Metric = std::pointer_traits<yy_values::Metrics::value_type>::element_type;
+using MetricObsPtr = yy_data::observer_ptr<Metric>;
+using MetricObsPtrs = yy_quad::simple_vector<MetricObsPtr>;
+
+// A metric and the json pointer it is read from.
+struct PointerMetric final
+{
+    std::string json_pointer{};
+    MetricObsPtr metric{};
+};
+
+using PointerMetrics = yy_quad::simple_vector<PointerMetric>;
+
 class JsonVisitor final
 {
   public:
     using MetricDataVector = yy_values::MetricDataVector;
     using Metrics = yy_values::Metrics;
+    using PointersSeen = yy_quad::simple_vector<const void *>;
 
-    constexpr JsonVisitor() noexcept = default;
-    constexpr JsonVisitor(const JsonVisitor &) noexcept = default;
+    JsonVisitor() noexcept = default;
+    JsonVisitor(const JsonVisitor &) = default;
     JsonVisitor(JsonVisitor && p_other) noexcept;
 
-    constexpr JsonVisitor & operator=(const JsonVisitor &) noexcept = default;
+    JsonVisitor & operator=(const JsonVisitor &) = default;
     JsonVisitor & operator=(JsonVisitor && p_other) noexcept;
 
     void levels(const yy_mqtt::TopicLevelsView * p_levels) noexcept;
     void metric_data(yy_values::MetricDataVectorPtr p_metric_data) noexcept;
     void topic(const std::string_view p_topic) noexcept;
     void timestamp(const timestamp_type p_timestamp) noexcept;
+    void pointer_count(size_type p_pointer_count);
     void reset() noexcept;
 
-    void apply_str(Metrics & metrics,
+    // True once every configured json pointer has matched a value, so
+    // the rest of the payload can be skipped.
+    [[nodiscard]]
+    constexpr bool all_pointers_seen() const noexcept
+    {
+      return (0 != m_pointer_count) && (m_pointers_seen.size() >= m_pointer_count);
+    }
+
+    template<typename MetricsType>
+    void apply_str(MetricsType & metrics,
                    std::string_view str)
     {
       apply(metrics, str, yy_values::ValueType::String);
     }
 
-    void apply_int64(Metrics & metrics,
+    template<typename MetricsType>
+    void apply_int64(MetricsType & metrics,
                      std::string_view raw,
-                     std::int64_t /* num */)
+                     std::int64_t num)
     {
-      apply(metrics, raw, yy_values::ValueType::Int);
+      apply(metrics, raw, yy_values::ValueType::Int, static_cast<double>(num));
     }
 
-    void apply_uint64(Metrics & metrics,
+    template<typename MetricsType>
+    void apply_uint64(MetricsType & metrics,
                       std::string_view raw,
-                      std::uint64_t /* num */)
+                      std::uint64_t num)
     {
-      apply(metrics, raw, yy_values::ValueType::UInt);
+      apply(metrics, raw, yy_values::ValueType::UInt, static_cast<double>(num));
     }
 
-    void apply_double(Metrics & metrics,
+    template<typename MetricsType>
+    void apply_double(MetricsType & metrics,
                       std::string_view raw,
-                      double /* num */)
+                      double num)
     {
-      apply(metrics, raw, yy_values::ValueType::Float);
+      apply(metrics, raw, yy_values::ValueType::Float, num);
     }
 
-    void apply_bool(Metrics & metrics,
+    template<typename MetricsType>
+    void apply_bool(MetricsType & metrics,
                     bool flag)
     {
       apply(metrics, flag ? g_true_str : g_false_str, yy_values::ValueType::Bool);
     }
 
   private:
-    void apply(Metrics & p_metrics,
-               std::string_view p_data,
-               yy_values::ValueType p_value_type);
+    template<typename MetricsType>
+    void apply(MetricsType & p_metrics,
+               std::string_view p_value,
+               yy_values::ValueType p_value_type)
+    {
+      pointer_seen(&p_metrics);
+
+      for(auto & metric : p_metrics)
+      {
+        metric->Event(p_value,
+                      m_topic,
+                      *m_levels,
+                      m_timestamp,
+                      p_value_type,
+                      m_metric_data);
+      }
+    }
+
+    // Numbers already decoded by the parser are passed on so the cache
+    // stage doesn't have to parse the text again.
+    template<typename MetricsType>
+    void apply(MetricsType & p_metrics,
+               std::string_view p_value,
+               yy_values::ValueType p_value_type,
+               double p_binary)
+    {
+      const size_type first = m_metric_data->size();
+
+      apply(p_metrics, p_value, p_value_type);
+
+      metric_data_set_binary(*m_metric_data, first, p_value, p_binary);
+    }
+
+    // Each json pointer has its own payload, so payload addresses
+    // identify the pointers seen. A duplicate key must not count twice.
+    void pointer_seen(const void * p_payload) noexcept
+    {
+      if(std::find(m_pointers_seen.begin(), m_pointers_seen.end(), p_payload) == m_pointers_seen.end())
+      {
+        m_pointers_seen.emplace_back(p_payload);
+      }
+    }
 
     static constexpr const std::string_view g_true_str{"true"};
     static constexpr const std::string_view g_false_str{"false"};
@@ -107,8 +182,86 @@ class JsonVisitor final
     yy_values::MetricDataVectorPtr m_metric_data{};
     timestamp_type m_timestamp{};
     std::string_view m_topic{};
+    PointersSeen m_pointers_seen{};
+    size_type m_pointer_count = 0;
+};
+
+// Stops the parser, by failing the value callback, once every json
+// pointer has been seen. Bytes after the last needed value aren't parsed.
+template<typename HandlerType>
+class StopWhenSeenHandler final:
+      public HandlerType
+{
+  public:
+    using HandlerType::HandlerType;
+
+    bool on_string(std::string_view p_str,
+                   std::size_t p_size,
+                   boost::json::error_code & p_ec)
+    {
+      return HandlerType::on_string(p_str, p_size, p_ec) && more(p_ec);
+    }
+
+    bool on_int64(std::int64_t p_num,
+                  std::string_view p_raw,
+                  boost::json::error_code & p_ec)
+    {
+      return HandlerType::on_int64(p_num, p_raw, p_ec) && more(p_ec);
+    }
+
+    bool on_uint64(std::uint64_t p_num,
+                   std::string_view p_raw,
+                   boost::json::error_code & p_ec)
+    {
+      return HandlerType::on_uint64(p_num, p_raw, p_ec) && more(p_ec);
+    }
+
+    bool on_double(double p_num,
+                   std::string_view p_raw,
+                   boost::json::error_code & p_ec)
+    {
+      return HandlerType::on_double(p_num, p_raw, p_ec) && more(p_ec);
+    }
+
+    bool on_bool(bool p_flag,
+                 boost::json::error_code & p_ec)
+    {
+      return HandlerType::on_bool(p_flag, p_ec) && more(p_ec);
+    }
+
+  private:
+    bool more(boost::json::error_code & p_ec)
+    {
+      if(this->visitor().all_pointers_seen())
+      {
+        p_ec = boost::system::errc::make_error_code(boost::system::errc::operation_canceled);
+        return false;
+      }
+
+      return true;
+    }
 };
 
+// Set up a json pointer handler (and its visitor) for a new payload.
+template<typename HandlerType>
+void prepare_handler(HandlerType & p_handler,
+                     const std::string_view p_topic,
+                     const yy_mqtt::TopicLevelsView & p_levels,
+                     const timestamp_type p_timestamp,
+                     yy_values::MetricDataVectorPtr p_metric_data,
+                     size_type p_pointer_count)
+{
+  p_handler.reset();
+  auto & visitor = p_handler.visitor();
+
+  visitor.reset();
+  visitor.levels(&p_levels);
+  visitor.metric_data(p_metric_data);
+  visitor.timestamp(p_timestamp);
+  visitor.topic(p_topic);
+  visitor.pointer_count(p_pointer_count);
+}
+
 } // namespace json_handler_detail
 
 class MqttJsonHandler final:
@@ -116,15 +269,18 @@ class MqttJsonHandler final:
 {
   public:
     using MetricDataVector = yy_values::MetricDataVector;
+    using PointerMetrics = json_handler_detail::PointerMetrics;
     using builder_type = yy_json::json_pointer_builder<yy_values::Metrics, json_handler_detail::JsonVisitor>;
     using handler_type = builder_type::handler_type;
     using handler_config_type = handler_type::pointers_config_type;
-    using parser_type = boost::json::basic_parser<handler_type>;
+    using parser_type = boost::json::basic_parser<json_handler_detail::StopWhenSeenHandler<handler_type>>;
     using parser_options_type = boost::json::parse_options;
 
     explicit MqttJsonHandler(std::string_view p_handler_id,
                              const parser_options_type & p_json_options,
                              handler_config_type && p_json_handler_config,
+                             PointerMetrics && p_pointer_metrics,
+                             size_type p_pointer_count,
                              size_type p_metric_count) noexcept;
 
     MqttJsonHandler() = delete;
@@ -140,8 +296,57 @@ class MqttJsonHandler final:
                const timestamp_type p_timestamp,
                yy_values::MetricDataVectorPtr p_metric_data) noexcept override;
 
+    // The json pointers & metrics of this handler. Used to build
+    // MqttJsonCombinedHandler.
+    [[nodiscard]]
+    constexpr const PointerMetrics & Pointers() const noexcept
+    {
+      return m_pointer_metrics;
+    }
+
+  private:
+    parser_type m_parser;
+    PointerMetrics m_pointer_metrics{};
+    size_type m_pointer_count = 0;
+};
+
+// Several json handlers subscribed to the same topics merged in to one
+// json pointer automaton, so a payload is parsed once for all of them.
+// The metrics are still owned by the original handlers.
+class MqttJsonCombinedHandler final:
+      public MqttHandler
+{
+  public:
+    using MetricDataVector = yy_values::MetricDataVector;
+    using MetricObsPtrs = json_handler_detail::MetricObsPtrs;
+    using builder_type = yy_json::json_pointer_builder<MetricObsPtrs, json_handler_detail::JsonVisitor>;
+    using handler_type = builder_type::handler_type;
+    using handler_config_type = handler_type::pointers_config_type;
+    using parser_type = boost::json::basic_parser<json_handler_detail::StopWhenSeenHandler<handler_type>>;
+    using parser_options_type = boost::json::parse_options;
+
+    explicit MqttJsonCombinedHandler(std::string_view p_handler_id,
+                                     const parser_options_type & p_json_options,
+                                     handler_config_type && p_json_handler_config,
+                                     size_type p_pointer_count,
+                                     size_type p_metric_count) noexcept;
+
+    MqttJsonCombinedHandler() = delete;
+    MqttJsonCombinedHandler(const MqttJsonCombinedHandler &) = delete;
+    constexpr MqttJsonCombinedHandler(MqttJsonCombinedHandler &&) noexcept = default;
+
+    MqttJsonCombinedHandler & operator=(const MqttJsonCombinedHandler &) = delete;
+    constexpr MqttJsonCombinedHandler & operator=(MqttJsonCombinedHandler &&) noexcept = default;
+
+    void Event(std::string_view p_mqtt_data,
+               const std::string_view p_topic,
+               const yy_mqtt::TopicLevelsView & p_levels,
+               const timestamp_type p_timestamp,
+               yy_values::MetricDataVectorPtr p_metric_data) noexcept override;
+
   private:
     parser_type m_parser;
+    size_type m_pointer_count = 0;
 };
 
 } // namespace yafiyogi::mendel
@@ -0,0 +1,431 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <chrono>
+#include <string_view>
+
+#include "spdlog/spdlog.h"
+
+#include "yy_values/yy_values_metric.hpp"
+#include "yy_values/yy_values_metric_data.hpp"
+
+#include "mqtt_handler_json_samples.h"
+
+namespace yafiyogi::mendel {
+
+using namespace std::string_view_literals;
+
+namespace json_samples_detail {
+
+SamplesHandler::SamplesHandler(PathTokens && p_samples_path,
+                               std::string && p_timestamp_field,
+                               double p_timestamp_scale,
+                               SampleFields && p_fields) noexcept:
+  m_samples_path(std::move(p_samples_path)),
+  m_timestamp_field(std::move(p_timestamp_field)),
+  m_timestamp_scale(p_timestamp_scale),
+  m_fields(std::move(p_fields))
+{
+  m_values.reserve(m_fields.size());
+}
+
+void SamplesHandler::reset(const std::string_view p_topic,
+                           const yy_mqtt::TopicLevelsView & p_levels,
+                           const timestamp_type p_timestamp,
+                           yy_values::MetricDataVectorPtr p_metric_data) noexcept
+{
+  m_topic = p_topic;
+  m_levels = &p_levels;
+  m_arrival = p_timestamp;
+  m_metric_data = p_metric_data;
+}
+
+bool SamplesHandler::on_document_begin(boost::json::error_code & /* p_ec */)
+{
+  m_text.clear();
+  m_depth = 0;
+  m_matched = 0;
+  m_samples_depth = 0;
+  m_field = no_field;
+  m_pending = false;
+  m_in_samples = false;
+  m_in_sample = false;
+  m_is_timestamp = false;
+  m_value_count = 0;
+
+  return true;
+}
+
+bool SamplesHandler::on_document_end(boost::json::error_code & /* p_ec */)
+{
+  return true;
+}
+
+bool SamplesHandler::on_object_begin(boost::json::error_code & /* p_ec */)
+{
+  begin_container(false);
+
+  return true;
+}
+
+bool SamplesHandler::on_object_end(std::size_t /* p_size */,
+                                   boost::json::error_code & /* p_ec */)
+{
+  return end_container();
+}
+
+bool SamplesHandler::on_array_begin(boost::json::error_code & /* p_ec */)
+{
+  begin_container(true);
+
+  return true;
+}
+
+bool SamplesHandler::on_array_end(std::size_t /* p_size */,
+                                  boost::json::error_code & /* p_ec */)
+{
+  return end_container();
+}
+
+bool SamplesHandler::on_key_part(std::string_view p_key,
+                                 std::size_t /* p_size */,
+                                 boost::json::error_code & /* p_ec */)
+{
+  m_text.append(p_key);
+
+  return true;
+}
+
+bool SamplesHandler::on_key(std::string_view p_key,
+                            std::size_t /* p_size */,
+                            boost::json::error_code & /* p_ec */)
+{
+  m_text.append(p_key);
+  key(m_text);
+  m_text.clear();
+
+  return true;
+}
+
+bool SamplesHandler::on_string_part(std::string_view p_str,
+                                    std::size_t /* p_size */,
+                                    boost::json::error_code & /* p_ec */)
+{
+  m_text.append(p_str);
+
+  return true;
+}
+
+bool SamplesHandler::on_string(std::string_view p_str,
+                               std::size_t /* p_size */,
+                               boost::json::error_code & /* p_ec */)
+{
+  m_text.append(p_str);
+  value(m_text, yy_values::ValueType::String, 0.0, false);
+  m_text.clear();
+
+  return true;
+}
+
+bool SamplesHandler::on_number_part(std::string_view p_raw,
+                                    boost::json::error_code & /* p_ec */)
+{
+  m_text.append(p_raw);
+
+  return true;
+}
+
+bool SamplesHandler::on_int64(std::int64_t p_num,
+                              std::string_view p_raw,
+                              boost::json::error_code & /* p_ec */)
+{
+  m_text.append(p_raw);
+  value(m_text, yy_values::ValueType::Int, static_cast<double>(p_num), true);
+  m_text.clear();
+
+  return true;
+}
+
+bool SamplesHandler::on_uint64(std::uint64_t p_num,
+                               std::string_view p_raw,
+                               boost::json::error_code & /* p_ec */)
+{
+  m_text.append(p_raw);
+  value(m_text, yy_values::ValueType::UInt, static_cast<double>(p_num), true);
+  m_text.clear();
+
+  return true;
+}
+
+bool SamplesHandler::on_double(double p_num,
+                               std::string_view p_raw,
+                               boost::json::error_code & /* p_ec */)
+{
+  m_text.append(p_raw);
+  value(m_text, yy_values::ValueType::Float, p_num, true);
+  m_text.clear();
+
+  return true;
+}
+
+bool SamplesHandler::on_bool(bool p_flag,
+                             boost::json::error_code & /* p_ec */)
+{
+  value(p_flag ? "true"sv : "false"sv, yy_values::ValueType::Bool, 0.0, false);
+
+  return true;
+}
+
+bool SamplesHandler::on_null(boost::json::error_code & /* p_ec */)
+{
+  m_pending = false;
+  m_field = no_field;
+  m_is_timestamp = false;
+
+  return true;
+}
+
+bool SamplesHandler::on_comment_part(std::string_view /* p_comment */,
+                                     boost::json::error_code & /* p_ec */)
+{
+  return true;
+}
+
+bool SamplesHandler::on_comment(std::string_view /* p_comment */,
+                                boost::json::error_code & /* p_ec */)
+{
+  return true;
+}
+
+// Containers on the path to the samples array are at depths
+// 1..(m_matched + 1).
+void SamplesHandler::begin_container(bool p_is_array) noexcept
+{
+  ++m_depth;
+
+  if(m_pending)
+  {
+    m_pending = false;
+    ++m_matched;
+  }
+
+  if(!m_in_samples)
+  {
+    if(p_is_array
+       && (m_matched == m_samples_path.size())
+       && (m_depth == (m_matched + 1)))
+    {
+      m_in_samples = true;
+      m_samples_depth = m_depth;
+    }
+  }
+  else if(!p_is_array && (m_depth == (m_samples_depth + 1)))
+  {
+    m_in_sample = true;
+    m_timestamp = m_arrival;
+    m_value_count = 0;
+  }
+
+  // Container values of sample fields are ignored.
+  m_field = no_field;
+  m_is_timestamp = false;
+}
+
+bool SamplesHandler::end_container() noexcept
+{
+  bool more = true;
+
+  if(m_in_samples)
+  {
+    if(m_in_sample && (m_depth == (m_samples_depth + 1)))
+    {
+      publish();
+      m_in_sample = false;
+    }
+    else if(m_depth == m_samples_depth)
+    {
+      // All samples read, skip the rest of the payload.
+      m_in_samples = false;
+      more = false;
+    }
+  }
+
+  if((0 != m_matched) && (m_depth == (m_matched + 1)))
+  {
+    --m_matched;
+  }
+
+  --m_depth;
+
+  return more;
+}
+
+void SamplesHandler::key(std::string_view p_key) noexcept
+{
+  m_pending = false;
+  m_field = no_field;
+  m_is_timestamp = false;
+
+  if(m_in_sample)
+  {
+    if(m_depth == (m_samples_depth + 1))
+    {
+      if(p_key == m_timestamp_field)
+      {
+        m_is_timestamp = true;
+      }
+      else
+      {
+        for(size_type idx = 0; idx < m_fields.size(); ++idx)
+        {
+          if(p_key == m_fields[idx].name)
+          {
+            m_field = idx;
+            break;
+          }
+        }
+      }
+    }
+  }
+  else if(!m_in_samples
+          && (m_matched < m_samples_path.size())
+          && (m_depth == (m_matched + 1))
+          && (p_key == m_samples_path[m_matched]))
+  {
+    m_pending = true;
+  }
+}
+
+void SamplesHandler::value(std::string_view p_value,
+                           yy_values::ValueType p_value_type,
+                           double p_binary,
+                           bool p_has_binary)
+{
+  m_pending = false;
+
+  if(m_in_sample && (m_depth == (m_samples_depth + 1)))
+  {
+    if(m_is_timestamp)
+    {
+      if(p_has_binary)
+      {
+        m_timestamp = std::chrono::duration_cast<timestamp_type>(std::chrono::duration<double, std::nano>{p_binary * m_timestamp_scale});
+      }
+    }
+    else if(no_field != m_field)
+    {
+      // Reuse values (& their string capacity) between samples.
+      if(m_value_count == m_values.size())
+      {
+        m_values.emplace_back(SampleValue{});
+      }
+
+      auto & sample_value = m_values[m_value_count];
+      ++m_value_count;
+
+      sample_value.field = m_field;
+      sample_value.value.assign(p_value);
+      sample_value.value_type = p_value_type;
+      sample_value.binary = p_binary;
+      sample_value.has_binary = p_has_binary;
+    }
+  }
+
+  m_field = no_field;
+  m_is_timestamp = false;
+}
+
+// The timestamp may come after the values, so values are published at
+// the end of each sample.
+void SamplesHandler::publish() noexcept
+{
+  for(size_type idx = 0; idx < m_value_count; ++idx)
+  {
+    const auto & sample_value = m_values[idx];
+    const size_type first = m_metric_data->size();
+
+    for(auto & metric : m_fields[sample_value.field].metrics)
+    {
+      metric->Event(sample_value.value,
+                    m_topic,
+                    *m_levels,
+                    m_timestamp,
+                    sample_value.value_type,
+                    m_metric_data);
+    }
+
+    if(sample_value.has_binary)
+    {
+      metric_data_set_binary(*m_metric_data,
+                             first,
+                             sample_value.value,
+                             sample_value.binary);
+    }
+  }
+
+  m_value_count = 0;
+}
+
+} // namespace json_samples_detail
+
+MqttJsonSamplesHandler::MqttJsonSamplesHandler(std::string_view p_handler_id,
+                                               const parser_options_type & p_json_options,
+                                               PathTokens && p_samples_path,
+                                               std::string && p_timestamp_field,
+                                               double p_timestamp_scale,
+                                               SampleFields && p_fields,
+                                               size_type p_metric_count) noexcept:
+  MqttHandler(p_handler_id, type::Json, p_metric_count),
+  m_parser(p_json_options,
+           std::move(p_samples_path),
+           std::move(p_timestamp_field),
+           p_timestamp_scale,
+           std::move(p_fields))
+{
+}
+
+void MqttJsonSamplesHandler::Event(std::string_view p_mqtt_data,
+                                   const std::string_view p_topic,
+                                   const yy_mqtt::TopicLevelsView & p_levels,
+                                   const timestamp_type p_timestamp,
+                                   yy_values::MetricDataVectorPtr p_metric_data) noexcept
+{
+  spdlog::debug("  handler [{}]"sv, Id());
+
+  m_parser.reset();
+  m_parser.handler().reset(p_topic,
+                           p_levels,
+                           p_timestamp,
+                           p_metric_data);
+
+  boost::json::error_code ec{};
+  m_parser.write_some(false,
+                      p_mqtt_data.data(),
+                      p_mqtt_data.size(),
+                      ec);
+}
+
+} // namespace yafiyogi::mendel
@@ -0,0 +1,201 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+#include "boost/json/basic_parser_impl.hpp"
+
+#include "yy_cpp/yy_observer_ptr.hpp"
+#include "yy_cpp/yy_vector.h"
+
+#include "yy_mqtt/yy_mqtt_types.h"
+
+#include "yy_values/yy_value_type.hpp"
+#include "yy_values/yy_values_metric.hpp"
+#include "yy_values/yy_values_metric_data.hpp"
+
+#include "mqtt_handler.h"
+
+namespace yafiyogi::mendel {
+namespace json_samples_detail {
+
+// A field of each sample & the metrics it is published to.
+struct SampleField final
+{
+    std::string name{};
+    yy_values::Metrics metrics{};
+};
+
+using SampleFields = yy_quad::simple_vector<SampleField>;
+using PathTokens = yy_quad::simple_vector<std::string>;
+
+struct SampleValue final
+{
+    size_type field = 0;
+    std::string value{};
+    yy_values::ValueType value_type = yy_values::ValueType::Unknown;
+    double binary = 0.0;
+    bool has_binary = false;
+};
+
+using SampleValues = yy_quad::simple_vector<SampleValue>;
+
+// boost::json basic_parser handler that finds the samples array (by a
+// path of object keys) & publishes the fields of each object in it with
+// the sample's own timestamp. Samples without a timestamp use the
+// arrival time. Parsing stops at the end of the samples array.
+class SamplesHandler final
+{
+  public:
+    static constexpr std::size_t max_object_size = std::numeric_limits<std::size_t>::max();
+    static constexpr std::size_t max_array_size = std::numeric_limits<std::size_t>::max();
+    static constexpr std::size_t max_key_size = std::numeric_limits<std::size_t>::max();
+    static constexpr std::size_t max_string_size = std::numeric_limits<std::size_t>::max();
+
+    explicit SamplesHandler(PathTokens && p_samples_path,
+                            std::string && p_timestamp_field,
+                            double p_timestamp_scale,
+                            SampleFields && p_fields) noexcept;
+
+    SamplesHandler() = delete;
+    SamplesHandler(const SamplesHandler &) = delete;
+    SamplesHandler(SamplesHandler &&) noexcept = default;
+
+    SamplesHandler & operator=(const SamplesHandler &) = delete;
+    SamplesHandler & operator=(SamplesHandler &&) noexcept = default;
+
+    void reset(const std::string_view p_topic,
+               const yy_mqtt::TopicLevelsView & p_levels,
+               const timestamp_type p_timestamp,
+               yy_values::MetricDataVectorPtr p_metric_data) noexcept;
+
+    bool on_document_begin(boost::json::error_code & p_ec);
+    bool on_document_end(boost::json::error_code & p_ec);
+    bool on_object_begin(boost::json::error_code & p_ec);
+    bool on_object_end(std::size_t p_size, boost::json::error_code & p_ec);
+    bool on_array_begin(boost::json::error_code & p_ec);
+    bool on_array_end(std::size_t p_size, boost::json::error_code & p_ec);
+    bool on_key_part(std::string_view p_key, std::size_t p_size, boost::json::error_code & p_ec);
+    bool on_key(std::string_view p_key, std::size_t p_size, boost::json::error_code & p_ec);
+    bool on_string_part(std::string_view p_str, std::size_t p_size, boost::json::error_code & p_ec);
+    bool on_string(std::string_view p_str, std::size_t p_size, boost::json::error_code & p_ec);
+    bool on_number_part(std::string_view p_raw, boost::json::error_code & p_ec);
+    bool on_int64(std::int64_t p_num, std::string_view p_raw, boost::json::error_code & p_ec);
+    bool on_uint64(std::uint64_t p_num, std::string_view p_raw, boost::json::error_code & p_ec);
+    bool on_double(double p_num, std::string_view p_raw, boost::json::error_code & p_ec);
+    bool on_bool(bool p_flag, boost::json::error_code & p_ec);
+    bool on_null(boost::json::error_code & p_ec);
+    bool on_comment_part(std::string_view p_comment, boost::json::error_code & p_ec);
+    bool on_comment(std::string_view p_comment, boost::json::error_code & p_ec);
+
+  private:
+    static constexpr size_type no_field = std::numeric_limits<size_type>::max();
+
+    void begin_container(bool p_is_array) noexcept;
+    bool end_container() noexcept;
+    void key(std::string_view p_key) noexcept;
+    void value(std::string_view p_value,
+               yy_values::ValueType p_value_type,
+               double p_binary,
+               bool p_has_binary);
+    void publish() noexcept;
+
+    PathTokens m_samples_path{};
+    std::string m_timestamp_field{};
+    double m_timestamp_scale = 1.0;
+    SampleFields m_fields{};
+
+    // Per payload.
+    std::string_view m_topic{};
+    yy_data::observer_ptr<std::add_const_t<yy_mqtt::TopicLevelsView>> m_levels{};
+    timestamp_type m_arrival{};
+    yy_values::MetricDataVectorPtr m_metric_data{};
+
+    // Parse state.
+    std::string m_text{};
+    size_type m_depth = 0;
+    size_type m_matched = 0;
+    size_type m_samples_depth = 0;
+    size_type m_field = no_field;
+    bool m_pending = false;
+    bool m_in_samples = false;
+    bool m_in_sample = false;
+    bool m_is_timestamp = false;
+
+    // Current sample.
+    timestamp_type m_timestamp{};
+    SampleValues m_values{};
+    size_type m_value_count = 0;
+};
+
+} // namespace json_samples_detail
+
+// Json handler for batched uploads: an array of samples, each an object
+// with its own timestamp.
+class MqttJsonSamplesHandler final:
+      public MqttHandler
+{
+  public:
+    using MetricDataVector = yy_values::MetricDataVector;
+    using PathTokens = json_samples_detail::PathTokens;
+    using SampleFields = json_samples_detail::SampleFields;
+    using handler_type = json_samples_detail::SamplesHandler;
+    using parser_type = boost::json::basic_parser<handler_type>;
+    using parser_options_type = boost::json::parse_options;
+
+    explicit MqttJsonSamplesHandler(std::string_view p_handler_id,
+                                    const parser_options_type & p_json_options,
+                                    PathTokens && p_samples_path,
+                                    std::string && p_timestamp_field,
+                                    double p_timestamp_scale,
+                                    SampleFields && p_fields,
+                                    size_type p_metric_count) noexcept;
+
+    MqttJsonSamplesHandler() = delete;
+    MqttJsonSamplesHandler(const MqttJsonSamplesHandler &) = delete;
+    MqttJsonSamplesHandler(MqttJsonSamplesHandler &&) noexcept = default;
+
+    MqttJsonSamplesHandler & operator=(const MqttJsonSamplesHandler &) = delete;
+    MqttJsonSamplesHandler & operator=(MqttJsonSamplesHandler &&) noexcept = default;
+
+    void Event(std::string_view p_mqtt_data,
+               const std::string_view p_topic,
+               const yy_mqtt::TopicLevelsView & p_levels,
+               const timestamp_type p_timestamp,
+               yy_values::MetricDataVectorPtr p_metric_data) noexcept override;
+
+  private:
+    parser_type m_parser;
+};
+
+} // namespace yafiyogi::mendel
@@ -0,0 +1,119 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <algorithm>
+#include <string_view>
+
+#include "spdlog/spdlog.h"
+
+#include "yy_values/yy_value_type.hpp"
+#include "yy_values/yy_values_metric.hpp"
+#include "yy_values/yy_values_metric_data.hpp"
+
+#include "mqtt_handler_text.h"
+
+namespace yafiyogi::mendel {
+
+using namespace std::string_view_literals;
+
+MqttTextHandler::MqttTextHandler(std::string_view p_handler_id,
+                                 PatternSetPtr && p_pattern_set,
+                                 Patterns && p_patterns,
+                                 yy_values::Metrics && p_metrics,
+                                 size_type p_metrics_count) noexcept:
+  MqttHandler(p_handler_id, type::Text, p_metrics_count),
+  m_pattern_set(std::move(p_pattern_set)),
+  m_patterns(std::move(p_patterns)),
+  m_metrics(std::move(p_metrics))
+{
+  int max_submatch_count = 0;
+  for(const auto & pattern : m_patterns)
+  {
+    max_submatch_count = std::max(max_submatch_count, pattern.submatch_count);
+  }
+
+  m_matches.reserve(m_patterns.size());
+  m_submatches.resize(static_cast<size_type>(max_submatch_count));
+}
+
+void MqttTextHandler::Event(std::string_view p_mqtt_data,
+                            const std::string_view p_topic,
+                            const yy_mqtt::TopicLevelsView & p_levels,
+                            const timestamp_type p_timestamp,
+                            yy_values::MetricDataVectorPtr p_metric_data) noexcept
+{
+  spdlog::debug("  handler [{}]"sv, Id());
+
+  const re2::StringPiece text{p_mqtt_data.data(), p_mqtt_data.size()};
+
+  m_matches.clear();
+  if(!m_pattern_set->Match(text, &m_matches))
+  {
+    return;
+  }
+
+  // Publish in configuration order.
+  std::sort(m_matches.begin(), m_matches.end());
+
+  for(const int match : m_matches)
+  {
+    const auto & pattern = m_patterns[static_cast<size_type>(match)];
+
+    if(!pattern.regex->Match(text,
+                             0,
+                             text.size(),
+                             RE2::UNANCHORED,
+                             m_submatches.data(),
+                             pattern.submatch_count))
+    {
+      continue;
+    }
+
+    for(const auto & [group, metrics] : pattern.groups)
+    {
+      const auto & submatch = m_submatches[static_cast<size_type>(group)];
+      if(nullptr == submatch.data())
+      {
+        // Optional group didn't participate in the match.
+        continue;
+      }
+
+      const std::string_view value{submatch.data(), submatch.size()};
+
+      for(auto & metric : metrics)
+      {
+        metric->Event(value,
+                      p_topic,
+                      p_levels,
+                      p_timestamp,
+                      yy_values::ValueType::Unknown,
+                      p_metric_data);
+      }
+    }
+  }
+}
+
+} // namespace yafiyogi::mendel
@@ -0,0 +1,112 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <memory>
+#include <string_view>
+#include <vector>
+
+#include "re2/re2.h"
+#include "re2/set.h"
+
+#include "yy_cpp/yy_observer_ptr.hpp"
+#include "yy_cpp/yy_vector.h"
+
+#include "yy_mqtt/yy_mqtt_types.h"
+
+#include "yy_values/yy_values_metric.hpp"
+#include "yy_values/yy_values_metric_data.hpp"
+
+#include "mqtt_handler.h"
+
+namespace yafiyogi::mendel {
+namespace text_handler_detail {
+
+using Metric = std::pointer_traits<yy_values::Metrics::value_type>::element_type;
+using MetricObsPtr = yy_data::observer_ptr<Metric>;
+using MetricObsPtrs = yy_quad::simple_vector<MetricObsPtr>;
+
+// A named capture group of a pattern & the metrics it is published to.
+struct PatternGroup final
+{
+    int group = 0;
+    MetricObsPtrs metrics{};
+};
+
+using PatternGroups = yy_quad::simple_vector<PatternGroup>;
+
+struct Pattern final
+{
+    std::unique_ptr<RE2> regex{};
+    PatternGroups groups{};
+    int submatch_count = 0;
+};
+
+using Patterns = yy_quad::simple_vector<Pattern>;
+
+} // namespace text_handler_detail
+
+// Extracts values from plain text payloads with regular expressions.
+// All patterns are compiled in to one RE2::Set, so a payload is scanned
+// once to find which patterns match. Only matching patterns are then
+// run to extract their named capture groups.
+class MqttTextHandler final:
+      public MqttHandler
+{
+  public:
+    using MetricDataVector = yy_values::MetricDataVector;
+    using Patterns = text_handler_detail::Patterns;
+    using PatternSetPtr = std::unique_ptr<RE2::Set>;
+
+    explicit MqttTextHandler(std::string_view p_handler_id,
+                             PatternSetPtr && p_pattern_set,
+                             Patterns && p_patterns,
+                             yy_values::Metrics && p_metrics,
+                             size_type p_metrics_count) noexcept;
+
+    MqttTextHandler() = delete;
+    MqttTextHandler(const MqttTextHandler &) = delete;
+    MqttTextHandler(MqttTextHandler &&) noexcept = default;
+
+    MqttTextHandler & operator=(const MqttTextHandler &) = delete;
+    MqttTextHandler & operator=(MqttTextHandler &&) noexcept = default;
+
+    void Event(std::string_view p_mqtt_data,
+               const std::string_view p_topic,
+               const yy_mqtt::TopicLevelsView & p_levels,
+               const timestamp_type p_timestamp,
+               yy_values::MetricDataVectorPtr p_metric_data) noexcept override;
+
+  private:
+    PatternSetPtr m_pattern_set{};
+    Patterns m_patterns{};
+    yy_values::Metrics m_metrics{};
+    std::vector<int> m_matches{};
+    std::vector<re2::StringPiece> m_submatches{};
+};
+
+} // namespace yafiyogi::mendel
@@ -0,0 +1,80 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <string>
+
+#include "yy_cpp/yy_ring_buffer.h"
+#include "yy_cpp/yy_types.hpp"
+#include "yy_cpp/yy_vector.h"
+
+#include "yy_values/yy_values_metric_data.hpp"
+
+namespace yafiyogi::mendel {
+
+// A received MQTT message waiting to be parsed. Messages are swapped,
+// never copied, through the parser queues, so the topic & payload
+// buffers are recycled between the network thread & the parser.
+struct MqttMessage final
+{
+    // MQTT v5 subscription identifiers sent by the broker. If there are
+    // none (or too many) the topic is matched against the filters instead.
+    static constexpr size_type max_subscription_ids = 8;
+    using SubscriptionIds = std::array<std::uint32_t, max_subscription_ids>;
+
+    std::string topic{};
+    std::string payload{};
+    timestamp_type timestamp{};
+    SubscriptionIds subscription_ids{};
+    size_type subscription_id_count = 0;
+
+    constexpr void swap(MqttMessage & other) noexcept
+    {
+      if(this != &other)
+      {
+        std::swap(topic, other.topic);
+        std::swap(payload, other.payload);
+        std::swap(timestamp, other.timestamp);
+        std::swap(subscription_ids, other.subscription_ids);
+        std::swap(subscription_id_count, other.subscription_id_count);
+      }
+    }
+
+    friend constexpr void swap(MqttMessage & lhs, MqttMessage & rhs) noexcept
+    {
+      lhs.swap(rhs);
+    }
+};
+
+using MqttMessageQueue = yy_data::ring_buffer<MqttMessage, 256>;
+using MqttMessageQueueReader = yy_data::ring_buffer_reader<MqttMessageQueue>;
+using MqttMessageQueueWriter = yy_data::ring_buffer_writer<MqttMessageQueue>;
+using MqttMessageQueueWriters = yy_quad::simple_vector<MqttMessageQueueWriter>;
+
+} // namespace yafiyogi::mendel
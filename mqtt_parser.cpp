@@ -0,0 +1,169 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <string_view>
+
+#include "spdlog/spdlog.h"
+
+#include "yy_mqtt/yy_mqtt_util.h"
+
+#include "configure_mqtt_client.h"
+#include "mqtt_handler.h"
+
+#include "mqtt_parser.h"
+
+namespace yafiyogi::mendel {
+
+using namespace std::string_view_literals;
+
+namespace {
+
+constexpr size_type spin_max = 400;
+
+} // anonymous namespace
+
+MqttParser::MqttParser(mqtt_client_config & p_client_config,
+                       MqttMessageQueueReader && p_queue,
+                       values::MetricDataLaneWriter && p_cache_queue):
+  m_handlers(std::move(p_client_config.handlers)),
+  m_subscription_handlers(std::move(p_client_config.subscription_handlers)),
+  m_topics(std::move(p_client_config.topics)),
+  m_queue(std::move(p_queue)),
+  m_cache_queue(std::move(p_cache_queue))
+{
+}
+
+void MqttParser::Run(std::stop_token p_stop_token)
+{
+  size_type spin = 1; // Set to 1 to prevent spinning at startup.
+  while(!p_stop_token.stop_requested())
+  {
+    while(m_queue.QSwapOut(m_message))
+    {
+      spin = spin_max; // Reset spin count.
+
+      Parse(m_message);
+    }
+
+    if(0 == --spin)
+    {
+      spin = spin_max; // Reset spin count.
+      m_queue.QWait(p_stop_token, [this] { return !m_queue.QEmpty();});
+    }
+  }
+}
+
+void MqttParser::Parse(const MqttMessage & p_message)
+{
+  m_inflater.Reset();
+
+  if(!ParseSubscriptions(p_message))
+  {
+    ParseTopics(p_message);
+  }
+}
+
+bool MqttParser::ParseSubscriptions(const MqttMessage & p_message)
+{
+  // The broker has already matched the topic, so use the subscription
+  // identifiers it sent to find the handlers.
+  if(0 == p_message.subscription_id_count)
+  {
+    return false;
+  }
+
+  for(size_type idx = 0; idx < p_message.subscription_id_count; ++idx)
+  {
+    if(const auto subscription_id = p_message.subscription_ids[idx];
+       (0 == subscription_id) || (subscription_id > m_subscription_handlers.size()))
+    {
+      return false;
+    }
+  }
+
+  std::string_view topic{p_message.topic};
+  spdlog::debug("Parser Processing [{}] subscriptions=[{}]"sv, topic, p_message.subscription_id_count);
+  yy_mqtt::topic_tokenize_view(m_path, topic);
+
+  size_type metric_count = 0;
+  m_metric_data.clear(yy_data::ClearAction::Keep);
+
+  for(size_type idx = 0; idx < p_message.subscription_id_count; ++idx)
+  {
+    Event(m_subscription_handlers[p_message.subscription_ids[idx] - 1], p_message, metric_count);
+  }
+
+  m_cache_queue.QSwapIn(m_metric_data);
+
+  return true;
+}
+
+void MqttParser::ParseTopics(const MqttMessage & p_message)
+{
+  std::string_view topic{p_message.topic};
+  if(auto payloads = m_topics.find(topic);
+     !payloads.empty())
+  {
+    spdlog::debug("Parser Processing [{}] payloads=[{}]"sv, topic, payloads.size());
+    yy_mqtt::topic_tokenize_view(m_path, topic);
+
+    size_type metric_count = 0;
+    m_metric_data.clear(yy_data::ClearAction::Keep);
+
+    for(auto & handlers : payloads)
+    {
+      Event(*handlers, p_message, metric_count);
+    }
+
+    m_cache_queue.QSwapIn(m_metric_data);
+  }
+}
+
+void MqttParser::Event(const MqttHandlerList & p_handlers,
+                       const MqttMessage & p_message,
+                       size_type & p_metric_count)
+{
+  const std::string_view topic{p_message.topic};
+  const std::string_view data{p_message.payload};
+  yy_values::MetricDataVectorPtr metric_data{&m_metric_data};
+
+  for(auto & handler : p_handlers)
+  {
+    std::string_view handler_data{};
+    if(!m_inflater.Inflate(data, handler->Compression(), handler_data))
+    {
+      spdlog::debug("  handler [{}] failed to inflate payload"sv, handler->Id());
+      continue;
+    }
+
+    p_metric_count += handler->MetricCount();
+    m_metric_data.reserve(p_metric_count);
+
+    handler->Event(handler_data, topic, m_path, p_message.timestamp, metric_data);
+  }
+}
+
+} // namespace yafiyogi::mendel
@@ -0,0 +1,85 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <memory>
+#include <stop_token>
+
+#include "yy_mqtt/yy_mqtt_types.h"
+#include "yy_values/yy_values_metric_data.hpp"
+
+#include "mqtt_handler_fwd.h"
+#include "mqtt_message.h"
+#include "mqtt_topics.h"
+#include "payload_inflater.h"
+#include "values_metric_data_lanes.hpp"
+
+namespace yafiyogi::mendel {
+
+struct mqtt_client_config;
+
+// Runs the handlers for messages received by an mqtt_client, off the
+// mosquitto network thread.
+class MqttParser final
+{
+  public:
+    MqttParser(mqtt_client_config & p_client_config,
+               MqttMessageQueueReader && p_queue,
+               values::MetricDataLaneWriter && p_cache_queue);
+
+    MqttParser() = delete;
+    MqttParser(const MqttParser &) = delete;
+    MqttParser(MqttParser &&) noexcept = default;
+
+    MqttParser & operator=(const MqttParser &) = delete;
+    MqttParser & operator=(MqttParser &&) noexcept = default;
+
+    void Run(std::stop_token p_stop_token);
+
+  private:
+    void Parse(const MqttMessage & p_message);
+    [[nodiscard]]
+    bool ParseSubscriptions(const MqttMessage & p_message);
+    void ParseTopics(const MqttMessage & p_message);
+    void Event(const MqttHandlerList & p_handlers,
+               const MqttMessage & p_message,
+               size_type & p_metric_count);
+
+    MqttHandlerStore m_handlers{};
+    SubscriptionHandlers m_subscription_handlers{};
+    Topics m_topics{};
+    yy_mqtt::TopicLevelsView m_path{};
+    MqttMessage m_message{};
+    yy_values::MetricDataVector m_metric_data{};
+    PayloadInflater m_inflater{};
+    MqttMessageQueueReader m_queue{};
+    values::MetricDataLaneWriter m_cache_queue{};
+};
+
+using MqttParserPtr = std::shared_ptr<MqttParser>;
+
+} // namespace yafiyogi::mendel
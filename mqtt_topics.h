@@ -38,6 +38,10 @@ namespace yafiyogi::mendel {
 
 using Subscriptions = yy_quad::simple_vector<std::string>;
 
+// Handlers for each subscription, indexed by MQTT v5 subscription
+// identifier - 1.
+using SubscriptionHandlers = yy_quad::simple_vector<MqttHandlerList>;
+
 using TopicsConfig = yy_mqtt::variant_state_topics<MqttHandlerList>;
 using Topics = TopicsConfig::automaton_type;
 
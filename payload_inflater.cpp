@@ -0,0 +1,165 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <algorithm>
+#include <string_view>
+
+#include "spdlog/spdlog.h"
+
+#include "payload_inflater.h"
+
+namespace yafiyogi::mendel {
+
+using namespace std::string_view_literals;
+
+namespace {
+
+// zlib window bits: 15 for the zlib format, + 16 for the gzip format.
+constexpr int g_deflate_window_bits = 15;
+constexpr int g_gzip_window_bits = 15 + 16;
+
+constexpr size_type g_min_buffer_size = 4096;
+// Guard against decompression bombs.
+constexpr size_type g_max_buffer_size = 64 * 1024 * 1024;
+
+} // anonymous namespace
+
+void PayloadInflater::StreamDeleter::operator()(z_stream * p_stream) const noexcept
+{
+  inflateEnd(p_stream);
+  delete p_stream;
+}
+
+void PayloadInflater::Reset() noexcept
+{
+  m_deflate.done = false;
+  m_gzip.done = false;
+}
+
+bool PayloadInflater::Inflate(std::string_view p_payload,
+                              compression p_compression,
+                              std::string_view & p_inflated)
+{
+  Inflated * inflated = nullptr;
+  int window_bits = 0;
+
+  switch(p_compression)
+  {
+    case compression::Deflate:
+      inflated = &m_deflate;
+      window_bits = g_deflate_window_bits;
+      break;
+
+    case compression::Gzip:
+      inflated = &m_gzip;
+      window_bits = g_gzip_window_bits;
+      break;
+
+    case compression::None:
+      p_inflated = p_payload;
+      return true;
+  }
+
+  if(!inflated->done)
+  {
+    inflated->done = true;
+    inflated->ok = Inflate(*inflated, p_payload, window_bits);
+  }
+
+  p_inflated = std::string_view{inflated->buffer.data(), inflated->size};
+
+  return inflated->ok;
+}
+
+bool PayloadInflater::Inflate(Inflated & p_inflated,
+                              std::string_view p_payload,
+                              int p_window_bits)
+{
+  p_inflated.size = 0;
+
+  if(!p_inflated.stream)
+  {
+    StreamPtr stream{new z_stream{}};
+
+    if(Z_OK != inflateInit2(stream.get(), p_window_bits))
+    {
+      spdlog::error("Failed to initialise zlib [{}]"sv, stream->msg ? stream->msg : "");
+      return false;
+    }
+
+    p_inflated.stream = std::move(stream);
+  }
+  else if(Z_OK != inflateReset(p_inflated.stream.get()))
+  {
+    return false;
+  }
+
+  auto & buffer = p_inflated.buffer;
+  if(buffer.size() < g_min_buffer_size)
+  {
+    buffer.resize(g_min_buffer_size);
+  }
+
+  z_stream & stream = *p_inflated.stream;
+  stream.next_in = reinterpret_cast<Bytef *>(const_cast<char *>(p_payload.data()));
+  stream.avail_in = static_cast<uInt>(p_payload.size());
+
+  size_type used = 0;
+  int rc = Z_OK;
+  while(Z_STREAM_END != rc)
+  {
+    if(used == buffer.size())
+    {
+      if(buffer.size() >= g_max_buffer_size)
+      {
+        spdlog::warn("Inflated payload larger than [{}] bytes"sv, g_max_buffer_size);
+        return false;
+      }
+
+      buffer.resize(std::min(buffer.size() * 2, g_max_buffer_size));
+    }
+
+    stream.next_out = reinterpret_cast<Bytef *>(buffer.data() + used);
+    stream.avail_out = static_cast<uInt>(buffer.size() - used);
+
+    rc = inflate(&stream, Z_NO_FLUSH);
+    used = buffer.size() - stream.avail_out;
+
+    if(((Z_OK != rc) && (Z_STREAM_END != rc))
+       || ((Z_OK == rc) && (0 == stream.avail_in) && (0 != stream.avail_out)))
+    {
+      // Corrupt or truncated payload.
+      spdlog::debug("Failed to inflate payload [{}]"sv, stream.msg ? stream.msg : "");
+      return false;
+    }
+  }
+
+  p_inflated.size = used;
+
+  return true;
+}
+
+} // namespace yafiyogi::mendel
@@ -0,0 +1,91 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <string_view>
+
+#include "zlib.h"
+
+#include "yy_cpp/yy_types.hpp"
+
+#include "mqtt_handler.h"
+
+namespace yafiyogi::mendel {
+
+// Inflates compressed payloads for handlers with a 'compression' option.
+// Each compression has its own zlib stream & output buffer, which are
+// reused (& only grow) between payloads. A payload is only inflated once
+// per compression, however many handlers use it.
+class PayloadInflater final
+{
+  public:
+    using compression = MqttHandler::compression;
+
+    PayloadInflater() noexcept = default;
+    PayloadInflater(const PayloadInflater &) = delete;
+    PayloadInflater(PayloadInflater &&) noexcept = default;
+
+    PayloadInflater & operator=(const PayloadInflater &) = delete;
+    PayloadInflater & operator=(PayloadInflater &&) noexcept = default;
+
+    // Call for each new payload.
+    void Reset() noexcept;
+
+    [[nodiscard]]
+    bool Inflate(std::string_view p_payload,
+                 compression p_compression,
+                 std::string_view & p_inflated);
+
+  private:
+    struct StreamDeleter final
+    {
+        void operator()(z_stream * p_stream) const noexcept;
+    };
+
+    using StreamPtr = std::unique_ptr<z_stream, StreamDeleter>;
+
+    struct Inflated final
+    {
+        StreamPtr stream{};
+        std::string buffer{};
+        size_type size = 0;
+        bool done = false;
+        bool ok = false;
+    };
+
+    [[nodiscard]]
+    static bool Inflate(Inflated & p_inflated,
+                        std::string_view p_payload,
+                        int p_window_bits);
+
+    Inflated m_deflate{};
+    Inflated m_gzip{};
+};
+
+} // namespace yafiyogi::mendel
@@ -0,0 +1,81 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <stop_token>
+
+namespace yafiyogi::mendel {
+
+// Lets a single consumer sleep on several queues at once. Producers
+// Ring() after pushing, the consumer Wait()s until the predicate holds.
+class QueueDoorbell final
+{
+  public:
+    constexpr QueueDoorbell() noexcept = default;
+    QueueDoorbell(const QueueDoorbell &) = delete;
+    QueueDoorbell(QueueDoorbell &&) = delete;
+
+    QueueDoorbell & operator=(const QueueDoorbell &) = delete;
+    QueueDoorbell & operator=(QueueDoorbell &&) = delete;
+
+    void Ring() noexcept
+    {
+      m_rings.fetch_add(1, std::memory_order_release);
+      m_rings.notify_one();
+    }
+
+    template<typename Predicate>
+    void Wait(std::stop_token p_stop_token,
+              Predicate && p_ready)
+    {
+      std::stop_callback on_stop{p_stop_token, [this] { Ring(); }};
+
+      while(!p_stop_token.stop_requested())
+      {
+        // Read the ring count before testing the queues so a push
+        // between the test & the wait can't be missed.
+        const auto rings = m_rings.load(std::memory_order_acquire);
+
+        if(p_ready())
+        {
+          return;
+        }
+
+        m_rings.wait(rings, std::memory_order_acquire);
+      }
+    }
+
+  private:
+    std::atomic<std::uint64_t> m_rings{0};
+};
+
+using QueueDoorbellPtr = std::shared_ptr<QueueDoorbell>;
+
+} // namespace yafiyogi::mendel
@@ -0,0 +1,298 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+// Runs values through the parser, cache & actions threads (no broker)
+// & fails if an actions batch allocates after warm up. Only built with
+// MENDEL_ALLOCATION_TEST (see CMakeLists.txt). Actions in 'matrix' mode
+// use the ekf, which allocates, so there are none here.
+
+#include <chrono>
+#include <cmath>
+#include <memory>
+#include <string_view>
+#include <thread>
+
+#include "fmt/format.h"
+#include "spdlog/spdlog.h"
+
+#include "yy_cpp/yy_yaml_util.h"
+#include "yy_values/yy_configure_values.hpp"
+
+#include "action_timer_queue.hpp"
+#include "actions_handler.hpp"
+#include "actions_result_queue.hpp"
+#include "allocation_counter.hpp"
+#include "cache_handler.hpp"
+#include "configure_actions.hpp"
+#include "configure_mqtt_client.h"
+#include "mqtt_message.h"
+#include "mqtt_parser.h"
+#include "queue_doorbell.hpp"
+#include "values_metric_data_lanes.hpp"
+#include "values_store_cache.hpp"
+
+namespace yafiyogi {
+namespace {
+
+using namespace std::string_view_literals;
+
+constexpr size_type g_rounds = 1000;
+constexpr size_type g_action_workers = 2;
+constexpr auto g_result_timeout{std::chrono::seconds{5}};
+
+// A Kalman action in each mode that shouldn't allocate: auto (a fixed
+// kernel), auto falling back to sequential, sequential, batch & a
+// chained action.
+constexpr std::string_view g_config{R"(
+mqtt:
+  handlers:
+    - id: 'sensor'
+      type: 'json'
+      properties:
+        ['temperature', 'humidity', 'pressure']
+
+  topics:
+    - id: 'Sensors'
+      subscriptions:
+        - 'test/+/sensor'
+      handlers:
+        ['sensor']
+
+values:
+  - value: 'Temperature'
+    handlers:
+      - handler_id: 'sensor'
+        property: 'temperature'
+        location: '\2'
+
+  - value: 'Humidity'
+    handlers:
+      - handler_id: 'sensor'
+        property: 'humidity'
+        location: '\2'
+
+  - value: 'Pressure'
+    handlers:
+      - handler_id: 'sensor'
+        property: 'pressure'
+        location: '\2'
+
+actions:
+  - action_id: 'auto-fixed'
+    type: 'kalman'
+    values:
+      - {in: 'Temperature:a', out: 'temperature'}
+      - {in: 'Humidity:a', out: 'humidity', max_age: 60}
+    output: {topic: 'Test/AutoFixed', value_id: 'Test:AutoFixed'}
+
+  - action_id: 'auto-velocity'
+    type: 'kalman'
+    model: 'constant_velocity'
+    values:
+      - {in: 'Temperature:b', out: 'temperature'}
+      - {in: 'Temperature:c', out: 'temperature'}
+    output: {topic: 'Test/AutoVelocity', value_id: 'Test:AutoVelocity'}
+
+  - action_id: 'auto-sequential'
+    type: 'kalman'
+    values:
+      - {in: 'Temperature:b', out: 'temperature'}
+      - {in: 'Humidity:b', out: 'humidity'}
+      - {in: 'Pressure:b', out: 'pressure'}
+    output: {topic: 'Test/AutoSequential', value_id: 'Test:AutoSequential'}
+
+  - action_id: 'sequential'
+    type: 'kalman'
+    mode: 'sequential'
+    model: 'constant_velocity'
+    values:
+      - {in: 'Temperature:a', out: 'temperature'}
+      - {in: 'Humidity:a', out: 'humidity'}
+    output: {topic: 'Test/Sequential', value_id: 'Test:Sequential'}
+
+  - action_id: 'batch-b'
+    type: 'kalman'
+    mode: 'batch'
+    values:
+      - {in: 'Temperature:b', out: 'temperature'}
+      - {in: 'Humidity:b', out: 'humidity'}
+    output: {topic: 'Test/BatchB', value_id: 'Test:BatchB'}
+
+  - action_id: 'batch-c'
+    type: 'kalman'
+    mode: 'batch'
+    values:
+      - {in: 'Temperature:c', out: 'temperature'}
+      - {in: 'Humidity:c', out: 'humidity'}
+    output: {topic: 'Test/BatchC', value_id: 'Test:BatchC'}
+
+  - action_id: 'chained'
+    type: 'kalman'
+    values:
+      - {in: 'Test:AutoFixed:temperature', out: 'temperature'}
+      - {in: 'Temperature:c', out: 'temperature', max_age: 60}
+    output: {topic: 'Test/Chained', value_id: 'Test:Chained'}
+)"};
+
+constexpr std::string_view g_locations[]{"a"sv, "b"sv, "c"sv};
+
+timestamp_type now() noexcept
+{
+  return timestamp_type{std::chrono::time_point_cast<std::chrono::nanoseconds>(std::chrono::system_clock::now()).time_since_epoch()};
+}
+
+} // anonymous namespace
+} // namespace yafiyogi
+
+int main()
+{
+  using namespace yafiyogi;
+  using namespace std::string_view_literals;
+
+  if constexpr(!mendel::g_count_allocations)
+  {
+    spdlog::error("Built without MENDEL_COUNT_ALLOCATIONS."sv);
+    return 1;
+  }
+
+  spdlog::set_level(spdlog::level::warn);
+
+  const YAML::Node yaml_config = YAML::Load(std::string{g_config});
+
+  auto values_config{yy_values::configure_values(yaml_config["values"sv])};
+  auto client_config{mendel::configure_mqtt_client(yaml_config["mqtt"sv], values_config)};
+
+  actions::StorePtr actions_store{};
+  values::StorePtr values_store{};
+  {
+    actions::StoreBuilder actions_builder{};
+    values::StoreBuilder values_builder{};
+
+    mendel::configure_actions(yaml_config["actions"sv],
+                              actions_builder,
+                              values_builder);
+
+    actions_store = actions_builder.Create();
+    values_store = values_builder.Create();
+  }
+
+  auto results_queue{std::make_shared<actions::ActionResultQueue>()};
+  actions::ActionResultQueueReader results_reader{results_queue};
+
+  auto actions_doorbell{std::make_shared<mendel::QueueDoorbell>()};
+  auto action_timer_queue{std::make_shared<actions::ActionTimerQueue>()};
+  auto action_queue{std::make_shared<values::MetricDataQueue>()};
+  auto actions_handler{std::make_shared<mendel::ActionsHandler>(std::move(actions_store),
+                                                                values_store,
+                                                                values::MetricDataQueueReader{action_queue},
+                                                                actions::ActionTimerQueueReader{action_timer_queue},
+                                                                actions_doorbell,
+                                                                actions::ActionResultQueueWriter{results_queue},
+                                                                g_action_workers)};
+
+  values::MetricDataLanes cache_lanes{1};
+  auto cache_writers{cache_lanes.Writers()};
+  auto cache_handler{std::make_shared<mendel::CacheHandler>(values_store,
+                                                            std::move(cache_lanes),
+                                                            values::MetricDataLaneWriter{values::MetricDataQueueWriter{action_queue},
+                                                                                         actions_doorbell},
+                                                            values::StoreCache::default_capacity)};
+
+  auto parser_queue{std::make_shared<mendel::MqttMessageQueue>()};
+  mendel::MqttMessageQueueWriter parser_writer{parser_queue};
+  auto parser{std::make_shared<mendel::MqttParser>(client_config,
+                                                   mendel::MqttMessageQueueReader{parser_queue},
+                                                   std::move(cache_writers[0]))};
+
+  bool timed_out = false;
+  {
+    std::jthread actions_thread{[&actions_handler](std::stop_token p_stop_token) {
+      actions_handler->Run(p_stop_token);
+    }};
+    std::jthread cache_thread{[&cache_handler](std::stop_token p_stop_token) {
+      cache_handler->Run(p_stop_token);
+    }};
+    std::jthread parser_thread{[&parser](std::stop_token p_stop_token) {
+      parser->Run(p_stop_token);
+    }};
+
+    mendel::MqttMessage message{};
+    actions::ActionResultVector results{};
+
+    // Each round waits for a batch of results, so every round is at
+    // least one actions batch.
+    for(size_type round = 0; (round < g_rounds) && !timed_out; ++round)
+    {
+      const double reading = std::sin(static_cast<double>(round) * 0.1);
+
+      for(const auto location : g_locations)
+      {
+        message.topic = fmt::format("test/{}/sensor"sv, location);
+        message.payload = fmt::format(R"({{"temperature":{},"humidity":{},"pressure":{}}})"sv,
+                                      20.0 + reading,
+                                      50.0 + reading,
+                                      1000.0 + reading);
+        message.timestamp = now();
+        message.subscription_id_count = 0;
+
+        while(!parser_writer.QSwapIn(message))
+        {
+          std::this_thread::yield();
+        }
+      }
+
+      const auto deadline = std::chrono::steady_clock::now() + g_result_timeout;
+      results.clear(yy_data::ClearAction::Keep);
+      while(!results_reader.QSwapOut(results))
+      {
+        if(std::chrono::steady_clock::now() > deadline)
+        {
+          spdlog::error("No actions results for round [{}]."sv, round);
+          timed_out = true;
+          break;
+        }
+        std::this_thread::yield();
+      }
+    }
+
+    parser_thread.request_stop();
+    cache_thread.request_stop();
+    actions_thread.request_stop();
+  }
+
+  const size_type batches = actions_handler->Batches();
+  const size_type allocating_batches = actions_handler->AllocatingBatches();
+
+  spdlog::warn("Actions batches [{}], allocating after warm up [{}]."sv, batches, allocating_batches);
+
+  if(timed_out || (batches <= mendel::ActionsHandler::allocation_warm_up) || (0 != allocating_batches))
+  {
+    spdlog::error("Action allocation test failed."sv);
+    return 1;
+  }
+
+  return 0;
+}
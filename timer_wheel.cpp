@@ -0,0 +1,92 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <algorithm>
+
+#include "timer_wheel.hpp"
+
+namespace yafiyogi::mendel {
+
+TimerWheel::TimerWheel(tick_type p_now) noexcept:
+  m_next(p_now)
+{
+  for(auto & level : m_slots)
+  {
+    level.fill(no_timer);
+  }
+}
+
+TimerWheel::timer_id TimerWheel::Create()
+{
+  m_timers.emplace_back(Timer{});
+
+  return m_timers.size() - 1;
+}
+
+void TimerWheel::Schedule(timer_id p_timer,
+                          tick_type p_expiry) noexcept
+{
+  m_timers[p_timer].expiry = p_expiry;
+  Link(p_timer);
+}
+
+void TimerWheel::Link(timer_id p_timer) noexcept
+{
+  auto & timer = m_timers[p_timer];
+  tick_type expiry = std::max(timer.expiry, m_next);
+  const tick_type delta = expiry - m_next;
+
+  size_type level = 0;
+  while(((level + 1) < level_count)
+        && (delta >= (tick_type{1} << (level_bits * (level + 1)))))
+  {
+    ++level;
+  }
+
+  if(delta >= wheel_span)
+  {
+    // Park in the furthest slot, relinked when it cascades.
+    expiry = m_next + wheel_span - 1;
+  }
+
+  auto & head = m_slots[level][(expiry >> (level * level_bits)) & slot_mask];
+  timer.next = head;
+  head = p_timer;
+}
+
+void TimerWheel::Cascade(size_type p_level,
+                         size_type p_slot) noexcept
+{
+  for(timer_id timer = std::exchange(m_slots[p_level][p_slot], no_timer); no_timer != timer;)
+  {
+    const timer_id next = std::exchange(m_timers[timer].next, no_timer);
+
+    Link(timer);
+    timer = next;
+  }
+}
+
+} // namespace yafiyogi::mendel
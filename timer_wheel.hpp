@@ -0,0 +1,154 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+#include "yy_cpp/yy_types.hpp"
+
+namespace yafiyogi::mendel {
+
+// Hierarchical timing wheel. Four levels of 64 slots cover 2^24 ticks,
+// timers further out wait in the top level until they are in range.
+// Timers live in a pool & are linked through the slots, so scheduling
+// & expiring a timer is O(1) & doesn't allocate.
+class TimerWheel final
+{
+  public:
+    using tick_type = std::uint64_t;
+    using timer_id = size_type;
+
+    static constexpr timer_id no_timer = std::numeric_limits<timer_id>::max();
+
+    explicit TimerWheel(tick_type p_now = 0) noexcept;
+
+    TimerWheel(const TimerWheel &) = delete;
+    TimerWheel(TimerWheel &&) noexcept = default;
+
+    TimerWheel & operator=(const TimerWheel &) = delete;
+    TimerWheel & operator=(TimerWheel &&) noexcept = default;
+
+    // Add an unscheduled timer.
+    [[nodiscard]]
+    timer_id Create();
+
+    // Schedule a timer that isn't scheduled (new or expired) to expire
+    // at p_expiry. Times in the past expire on the next tick.
+    void Schedule(timer_id p_timer,
+                  tick_type p_expiry) noexcept;
+
+    // Expire the timers due up to & including p_now, calling
+    // p_expired(timer, expiry) for each. The timer may be rescheduled.
+    template<typename Expired>
+    void Advance(tick_type p_now,
+                 Expired && p_expired)
+    {
+      while(m_next <= p_now)
+      {
+        const size_type slot = m_next & slot_mask;
+
+        if(0 == slot)
+        {
+          // Move the timers of the next higher level slot down.
+          for(size_type level = 1; level < level_count; ++level)
+          {
+            const size_type level_slot = (m_next >> (level * level_bits)) & slot_mask;
+
+            Cascade(level, level_slot);
+
+            if(0 != level_slot)
+            {
+              break;
+            }
+          }
+        }
+
+        const tick_type tick = m_next++;
+
+        for(timer_id timer = std::exchange(m_slots[0][slot], no_timer); no_timer != timer;)
+        {
+          auto & entry = m_timers[timer];
+          const timer_id next = std::exchange(entry.next, no_timer);
+
+          if(entry.expiry > tick)
+          {
+            // Was out of range of the wheel.
+            Link(timer);
+          }
+          else
+          {
+            p_expired(timer, entry.expiry);
+          }
+
+          timer = next;
+        }
+      }
+    }
+
+    [[nodiscard]]
+    constexpr tick_type Now() const noexcept
+    {
+      return m_next;
+    }
+
+    [[nodiscard]]
+    constexpr size_type size() const noexcept
+    {
+      return m_timers.size();
+    }
+
+  private:
+    struct Timer final
+    {
+        tick_type expiry = 0;
+        timer_id next = no_timer;
+    };
+
+    static constexpr size_type level_bits = 6;
+    static constexpr size_type slot_count = size_type{1} << level_bits;
+    static constexpr size_type slot_mask = slot_count - 1;
+    static constexpr size_type level_count = 4;
+    static constexpr tick_type wheel_span = tick_type{1} << (level_bits * level_count);
+
+    using Slots = std::array<timer_id, slot_count>;
+    using Levels = std::array<Slots, level_count>;
+
+    void Link(timer_id p_timer) noexcept;
+    void Cascade(size_type p_level,
+                 size_type p_slot) noexcept;
+
+    std::vector<Timer> m_timers{};
+    Levels m_slots{};
+    // The next tick to expire.
+    tick_type m_next = 0;
+};
+
+} // namespace yafiyogi::mendel
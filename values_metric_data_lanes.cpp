@@ -0,0 +1,108 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <algorithm>
+
+#include "values_metric_data_lanes.hpp"
+
+namespace yafiyogi::values {
+
+MetricDataLaneWriter::MetricDataLaneWriter(MetricDataQueueWriter && p_queue,
+                                           MetricDataDoorbellPtr p_doorbell) noexcept:
+  m_queue(std::move(p_queue)),
+  m_doorbell(std::move(p_doorbell))
+{
+}
+
+void MetricDataLaneWriter::QSwapIn(yy_values::MetricDataVector & p_data)
+{
+  m_queue.QSwapIn(p_data);
+  m_doorbell->Ring();
+}
+
+MetricDataLanes::MetricDataLanes(size_type p_lane_count):
+  m_doorbell(std::make_shared<mendel::QueueDoorbell>())
+{
+  p_lane_count = std::max(size_type{1}, p_lane_count);
+
+  m_queues.reserve(p_lane_count);
+  m_readers.reserve(p_lane_count);
+
+  for(size_type idx = 0; idx < p_lane_count; ++idx)
+  {
+    auto queue{std::make_shared<MetricDataQueue>()};
+
+    m_readers.emplace_back(MetricDataQueueReader{queue});
+    m_queues.emplace_back(std::move(queue));
+  }
+}
+
+MetricDataLaneWriters MetricDataLanes::Writers()
+{
+  MetricDataLaneWriters writers{};
+  writers.reserve(m_queues.size());
+
+  for(auto & queue : m_queues)
+  {
+    writers.emplace_back(MetricDataQueueWriter{queue}, m_doorbell);
+  }
+
+  return writers;
+}
+
+bool MetricDataLanes::QSwapOut(yy_values::MetricDataVector & p_data)
+{
+  for(size_type count = 0; count < m_readers.size(); ++count)
+  {
+    auto & reader = m_readers[m_next];
+
+    if(++m_next == m_readers.size())
+    {
+      m_next = 0;
+    }
+
+    if(reader.QSwapOut(p_data))
+    {
+      return true;
+    }
+  }
+
+  return false;
+}
+
+bool MetricDataLanes::QEmpty()
+{
+  return std::all_of(m_readers.begin(), m_readers.end(), [](auto & reader) {
+    return reader.QEmpty();
+  });
+}
+
+void MetricDataLanes::QWait(std::stop_token p_stop_token)
+{
+  m_doorbell->Wait(p_stop_token, [this] { return !QEmpty();});
+}
+
+} // namespace yafiyogi::values
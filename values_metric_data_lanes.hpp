@@ -0,0 +1,105 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <memory>
+#include <stop_token>
+
+#include "yy_cpp/yy_types.hpp"
+#include "yy_cpp/yy_vector.h"
+
+#include "yy_values/yy_values_metric_data.hpp"
+
+#include "queue_doorbell.hpp"
+#include "values_metric_data_queue.hpp"
+
+namespace yafiyogi::values {
+
+using MetricDataDoorbellPtr = std::shared_ptr<mendel::QueueDoorbell>;
+
+// Producer end of one lane. Each producer thread owns its own lane so
+// producers never contend with each other.
+class MetricDataLaneWriter final
+{
+  public:
+    MetricDataLaneWriter(MetricDataQueueWriter && p_queue,
+                         MetricDataDoorbellPtr p_doorbell) noexcept;
+
+    constexpr MetricDataLaneWriter() noexcept = default;
+    MetricDataLaneWriter(const MetricDataLaneWriter &) = delete;
+    MetricDataLaneWriter(MetricDataLaneWriter &&) noexcept = default;
+
+    MetricDataLaneWriter & operator=(const MetricDataLaneWriter &) = delete;
+    MetricDataLaneWriter & operator=(MetricDataLaneWriter &&) noexcept = default;
+
+    void QSwapIn(yy_values::MetricDataVector & p_data);
+
+  private:
+    MetricDataQueueWriter m_queue{};
+    MetricDataDoorbellPtr m_doorbell{};
+};
+
+using MetricDataLaneWriters = yy_quad::simple_vector<MetricDataLaneWriter>;
+
+// Consumer end of a set of lanes, drained round robin.
+class MetricDataLanes final
+{
+  public:
+    explicit MetricDataLanes(size_type p_lane_count);
+
+    MetricDataLanes() = delete;
+    MetricDataLanes(const MetricDataLanes &) = delete;
+    MetricDataLanes(MetricDataLanes &&) noexcept = default;
+
+    MetricDataLanes & operator=(const MetricDataLanes &) = delete;
+    MetricDataLanes & operator=(MetricDataLanes &&) noexcept = default;
+
+    [[nodiscard]]
+    MetricDataLaneWriters Writers();
+
+    [[nodiscard]]
+    size_type size() const noexcept
+    {
+      return m_queues.size();
+    }
+
+    bool QSwapOut(yy_values::MetricDataVector & p_data);
+    bool QEmpty();
+    void QWait(std::stop_token p_stop_token);
+
+  private:
+    using queue_ptr = std::shared_ptr<MetricDataQueue>;
+    using Queues = yy_quad::simple_vector<queue_ptr>;
+    using Readers = yy_quad::simple_vector<MetricDataQueueReader>;
+
+    Queues m_queues{};
+    Readers m_readers{};
+    MetricDataDoorbellPtr m_doorbell{};
+    size_type m_next = 0;
+};
+
+} // namespace yafiyogi::values
@@ -0,0 +1,134 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+
+#include "yy_cpp/yy_types.hpp"
+
+namespace yafiyogi::values {
+
+// Where a value came from.
+enum class Quality:uint8_t {Unset, Measured, Derived};
+
+// A consistent copy of a slot.
+struct ValueRecord final
+{
+    double value = 0.0;
+    timestamp_type timestamp{};
+    uint64_t updates = 0;
+    Quality quality = Quality::Unset;
+};
+
+// A store value read & written through a seqlock. Readers never block
+// & retry if a write happened while reading. The sequence is odd while
+// a write is in progress; it also counts the updates. Writers take the
+// sequence with a compare exchange, so a slot shared by the cache &
+// actions threads stays consistent.
+class ValueSlot final
+{
+  public:
+    constexpr ValueSlot() noexcept = default;
+    ValueSlot(const ValueSlot &) = delete;
+    ValueSlot(ValueSlot &&) = delete;
+
+    ValueSlot & operator=(const ValueSlot &) = delete;
+    ValueSlot & operator=(ValueSlot &&) = delete;
+
+    [[nodiscard]]
+    ValueRecord Load() const noexcept
+    {
+      ValueRecord record{};
+      uint64_t sequence = 0;
+
+      do
+      {
+        sequence = m_sequence.load(std::memory_order_acquire);
+
+        record.value = m_value.load(std::memory_order_relaxed);
+        record.timestamp = timestamp_type{m_timestamp.load(std::memory_order_relaxed)};
+        record.quality = m_quality.load(std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+      } while((0 != (sequence & 1)) || (sequence != m_sequence.load(std::memory_order_relaxed)));
+
+      record.updates = sequence / 2;
+
+      return record;
+    }
+
+    // Returns the value before the store.
+    double Store(double p_value,
+                 timestamp_type p_timestamp,
+                 Quality p_quality) noexcept
+    {
+      const uint64_t sequence = WriteBegin();
+      const double previous = m_value.load(std::memory_order_relaxed);
+
+      m_value.store(p_value, std::memory_order_relaxed);
+      m_timestamp.store(p_timestamp.count(), std::memory_order_relaxed);
+      m_quality.store(p_quality, std::memory_order_relaxed);
+
+      m_sequence.store(sequence + 2, std::memory_order_release);
+
+      return previous;
+    }
+
+    [[nodiscard]]
+    uint64_t Updates() const noexcept
+    {
+      return m_sequence.load(std::memory_order_acquire) / 2;
+    }
+
+  private:
+    uint64_t WriteBegin() noexcept
+    {
+      uint64_t sequence = m_sequence.load(std::memory_order_relaxed);
+
+      while((0 != (sequence & 1))
+            || !m_sequence.compare_exchange_weak(sequence,
+                                                 sequence + 1,
+                                                 std::memory_order_acquire,
+                                                 std::memory_order_relaxed))
+      {
+        sequence = m_sequence.load(std::memory_order_relaxed);
+      }
+
+      std::atomic_thread_fence(std::memory_order_release);
+
+      return sequence;
+    }
+
+    std::atomic<uint64_t> m_sequence{0};
+    std::atomic<double> m_value{0.0};
+    std::atomic<timestamp_type::rep> m_timestamp{0};
+    std::atomic<Quality> m_quality{Quality::Unset};
+};
+
+} // namespace yafiyogi::values
@@ -26,7 +26,10 @@
 
 #include <cstddef>
 
+#include <algorithm>
 #include <chrono>
+#include <string_view>
+#include <tuple>
 
 #include "spdlog/spdlog.h"
 
@@ -36,14 +39,91 @@
 
 namespace yafiyogi::values {
 
-void StoreBuilder::Add(const std::string & value_id)
+using namespace std::string_view_literals;
+
+Store::Store(store_type && p_store,
+             size_type p_block_count):
+  m_store(std::move(p_store)),
+  m_values(std::make_unique<ValueBlock[]>(p_block_count)),
+  m_size(p_block_count * values_per_block)
+{
+}
+
+Store::slot_type Store::Resolve(const yy_values::MetricId & p_metric) noexcept
+{
+  slot_type slot = no_slot;
+  auto do_get_slot = [&slot](auto p_slot) {
+    slot = *p_slot;
+  };
+
+  std::ignore = m_store.find(do_get_slot, p_metric);
+
+  return slot;
+}
+
+Store::slot_type Store::Resolve(std::string_view p_metric) const noexcept
 {
-  m_store_builder.add(value_id, value_type{});
+  slot_type slot = no_slot;
+  auto do_get_slot = [&slot](auto p_slot) {
+    slot = *p_slot;
+  };
+
+  std::ignore = m_store.find(do_get_slot, p_metric);
+
+  return slot;
+}
+
+void StoreBuilder::Add(const std::string & value_id,
+                       Writer p_writer)
+{
+  if(auto iter = std::find_if(m_values.begin(), m_values.end(), [&value_id](const ValueConfig & p_config) {
+    return p_config.value_id == value_id;
+  });
+     m_values.end() != iter)
+  {
+    if(iter->writer != p_writer)
+    {
+      iter->writer = Writer::Shared;
+    }
+  }
+  else
+  {
+    m_values.emplace_back(ValueConfig{value_id, p_writer});
+  }
 }
 
 StorePtr StoreBuilder::Create()
 {
-  return std::make_shared<Store>(m_store_builder.create_automaton());
+  // Slots are grouped by writer, each group starting on a new block, so
+  // the cache & actions threads never write to the same cache line.
+  store_builder_type store_builder{};
+  slot_type slot = 0;
+
+  for(const auto writer : {Writer::Cache, Writer::Actions, Writer::Shared})
+  {
+    const slot_type first = slot;
+
+    for(const auto & [value_id, value_writer] : m_values)
+    {
+      if(writer == value_writer)
+      {
+        store_builder.add(value_id, slot);
+        ++slot;
+      }
+    }
+
+    if(slot != first)
+    {
+      spdlog::debug("  values store writer [{}] slots [{}..{})"sv,
+                    static_cast<int>(writer),
+                    first,
+                    slot);
+      slot = ((slot + Store::values_per_block - 1) / Store::values_per_block) * Store::values_per_block;
+    }
+  }
+
+  return std::make_shared<Store>(store_builder.create_automaton(),
+                                 slot / Store::values_per_block);
 }
 
 } // namespace yafiyogi::values
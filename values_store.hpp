@@ -26,29 +26,53 @@
 
 #pragma once
 
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
 #include <memory>
 #include <mutex>
+#include <string>
 #include <string_view>
 
-#include "yy_cpp/yy_atomic_wrapper.hpp"
-#include "yy_cpp/yy_flat_map.h"
+#include "yy_cpp/yy_types.hpp"
+#include "yy_cpp/yy_vector.h"
 
 #include "values_metric_id_trie.hpp"
+#include "values_slot.hpp"
 
 namespace yafiyogi::values {
 
+// The thread that writes a value. Values written by different threads
+// are kept on different cache lines.
+enum class Writer:uint8_t {Cache, Actions, Shared};
+
+inline constexpr size_type g_cache_line_size = 64;
+
+// Values are held in contiguous cache line sized blocks indexed by slot.
+// The trie maps a value id to its slot, so ids can be resolved once (see
+// Resolve()) & values then accessed directly.
 class Store final
 {
   public:
-    using store_builder_type = metric_id_trie<yy_quad::AtomicWrapper<double>>;
+    using value_type = ValueSlot;
+    using value_ptr = std::add_pointer_t<value_type>;
+    using slot_type = size_type;
+    using store_builder_type = metric_id_trie<slot_type>;
     using store_type = store_builder_type::automaton_type;
-    using value_type = store_builder_type::value_type;
-    using value_ptr = store_builder_type::value_ptr;
 
-    Store(store_type && p_store):
-      m_store(std::move(p_store))
+    static constexpr slot_type no_slot = std::numeric_limits<slot_type>::max();
+    static constexpr size_type values_per_block = std::max(size_type{1}, g_cache_line_size / sizeof(value_type));
+
+    struct alignas(g_cache_line_size) ValueBlock final
     {
-    }
+        std::array<value_type, values_per_block> values{};
+    };
+
+    using values_type = std::unique_ptr<ValueBlock[]>;
+
+    Store(store_type && p_store,
+          size_type p_block_count);
 
     constexpr Store() noexcept = default;
     constexpr Store(const Store &) noexcept = delete;
@@ -57,24 +81,64 @@ class Store final
     constexpr Store & operator=(const Store &) noexcept = delete;
     constexpr Store & operator=(Store &&) noexcept = default;
 
+    // Returns no_slot if the value isn't in the store.
+    [[nodiscard]]
+    slot_type Resolve(const yy_values::MetricId & p_metric) noexcept;
+    [[nodiscard]]
+    slot_type Resolve(std::string_view p_metric) const noexcept;
+
+    [[nodiscard]]
+    value_type & Value(slot_type p_slot) noexcept
+    {
+      return m_values[p_slot / values_per_block].values[p_slot % values_per_block];
+    }
+
+    [[nodiscard]]
+    const value_type & Value(slot_type p_slot) const noexcept
+    {
+      return m_values[p_slot / values_per_block].values[p_slot % values_per_block];
+    }
+
+    [[nodiscard]]
+    constexpr size_type size() const noexcept
+    {
+      return m_size;
+    }
+
     template<typename Visitor>
     [[nodiscard]]
-    constexpr bool Find(Visitor && p_visitor,
-                        const yy_values::MetricId & p_metric) noexcept
+    bool Find(Visitor && p_visitor,
+              const yy_values::MetricId & p_metric) noexcept
     {
-      return m_store.find(std::forward<Visitor>(p_visitor), p_metric);
+      if(const auto slot = Resolve(p_metric);
+         no_slot != slot)
+      {
+        p_visitor(&Value(slot));
+        return true;
+      }
+
+      return false;
     }
 
     template<typename Visitor>
     [[nodiscard]]
-    constexpr bool Find(Visitor && p_visitor,
-                        std::string_view p_metric) const noexcept
+    bool Find(Visitor && p_visitor,
+              std::string_view p_metric) const noexcept
     {
-      return m_store.find(std::forward<Visitor>(p_visitor), p_metric);
+      if(const auto slot = Resolve(p_metric);
+         no_slot != slot)
+      {
+        p_visitor(&Value(slot));
+        return true;
+      }
+
+      return false;
     }
 
   private:
     store_type m_store{};
+    values_type m_values{};
+    size_type m_size = 0;
 };
 
 using StorePtr = std::shared_ptr<Store>;
@@ -82,14 +146,23 @@ using StorePtr = std::shared_ptr<Store>;
 class StoreBuilder final
 {
   public:
-    void Add(const std::string & value_id);
+    void Add(const std::string & value_id,
+             Writer p_writer);
     StorePtr Create();
 
   private:
     using store_builder_type = Store::store_builder_type;
-    using value_type = store_builder_type::value_type;
+    using slot_type = Store::slot_type;
+
+    struct ValueConfig final
+    {
+        std::string value_id{};
+        Writer writer = Writer::Cache;
+    };
+
+    using value_configs = yy_quad::simple_vector<ValueConfig>;
 
-    store_builder_type m_store_builder{};
+    value_configs m_values{};
 };
 
 } // namespace yafiyogi::values
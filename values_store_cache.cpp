@@ -0,0 +1,93 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#include <algorithm>
+#include <string_view>
+#include <utility>
+
+#include "spdlog/spdlog.h"
+
+#include "values_store_cache.hpp"
+
+namespace yafiyogi::values {
+
+using namespace std::string_view_literals;
+
+StoreCache::StoreCache(size_type p_capacity):
+  m_capacity(std::max(size_type{1}, p_capacity))
+{
+  m_cache.reserve(m_capacity);
+  m_clock.reserve(m_capacity);
+}
+
+StoreCache::slot_type StoreCache::Resolve(Store & p_store,
+                                          const yy_values::MetricId & p_metric_id)
+{
+  // Name & location separated by a character that can't be in either.
+  m_key.assign(p_metric_id.Name());
+  m_key += '\0';
+  m_key.append(p_metric_id.Location());
+
+  if(auto cached = m_cache.find(std::string_view{m_key});
+     m_cache.end() != cached)
+  {
+    cached->second.used = true;
+
+    return cached->second.slot;
+  }
+
+  const slot_type slot = p_store.Resolve(p_metric_id);
+  Add(slot);
+
+  return slot;
+}
+
+void StoreCache::Add(slot_type p_slot)
+{
+  if(m_clock.size() < m_capacity)
+  {
+    m_clock.emplace_back(m_cache.emplace(m_key, Entry{p_slot, false}).first);
+    return;
+  }
+
+  // Clock: skip (& clear) entries used since the hand last passed.
+  while(m_clock[m_hand]->second.used)
+  {
+    m_clock[m_hand]->second.used = false;
+    m_hand = (m_hand + 1) % m_capacity;
+  }
+
+  spdlog::debug("Store cache full [{}], replacing an entry."sv, m_capacity);
+
+  auto node = m_cache.extract(m_clock[m_hand]);
+  node.key().assign(m_key);
+  node.mapped() = Entry{p_slot, false};
+
+  m_clock[m_hand] = m_cache.insert(std::move(node)).position;
+  m_hand = (m_hand + 1) % m_capacity;
+}
+
+} // namespace yafiyogi::values
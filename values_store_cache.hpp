@@ -0,0 +1,100 @@
+/*
+
+  MIT License
+
+  Copyright (c) 2026 Yafiyogi
+
+  Permission is hereby granted, free of charge, to any person obtaining a copy
+  of this software and associated documentation files (the "Software"), to deal
+  in the Software without restriction, including without limitation the rights
+  to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+  copies of the Software, and to permit persons to whom the Software is
+  furnished to do so, subject to the following conditions:
+
+  The above copyright notice and this permission notice shall be included in all
+  copies or substantial portions of the Software.
+
+  THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+  IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+  FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+  AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+  LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+  OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+  SOFTWARE.
+
+*/
+
+#pragma once
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <string_view>
+#include <unordered_map>
+#include <vector>
+
+#include "yy_cpp/yy_types.hpp"
+
+#include "yy_values/yy_values_metric_id.hpp"
+
+#include "values_store.hpp"
+
+namespace yafiyogi::values {
+
+// Bounded cache of concrete metric ids (name & location expanded from
+// the topic) to their store slots, so metrics on known topics skip the
+// store trie walk. Metrics not in the store are cached too. When full,
+// an entry not used since the clock hand last passed it is replaced,
+// reusing its node, so a full cache doesn't allocate.
+class StoreCache final
+{
+  public:
+    using slot_type = Store::slot_type;
+
+    static constexpr size_type default_capacity = 4096;
+
+    explicit StoreCache(size_type p_capacity = default_capacity);
+
+    StoreCache(const StoreCache &) = delete;
+    StoreCache(StoreCache &&) noexcept = default;
+
+    StoreCache & operator=(const StoreCache &) = delete;
+    StoreCache & operator=(StoreCache &&) noexcept = default;
+
+    // Returns Store::no_slot if the metric isn't in the store.
+    [[nodiscard]]
+    slot_type Resolve(Store & p_store,
+                      const yy_values::MetricId & p_metric_id);
+
+  private:
+    struct KeyHash final
+    {
+        using is_transparent = void;
+
+        std::size_t operator()(std::string_view p_key) const noexcept
+        {
+          return std::hash<std::string_view>{}(p_key);
+        }
+    };
+
+    struct Entry final
+    {
+        slot_type slot = Store::no_slot;
+        bool used = false;
+    };
+
+    using cache_type = std::unordered_map<std::string, Entry, KeyHash, std::equal_to<>>;
+    // The cache never grows past its capacity, so it never rehashes &
+    // its iterators stay valid.
+    using clock_type = std::vector<cache_type::iterator>;
+
+    void Add(slot_type p_slot);
+
+    cache_type m_cache{};
+    clock_type m_clock{};
+    size_type m_hand = 0;
+    std::string m_key{};
+    size_type m_capacity = default_capacity;
+};
+
+} // namespace yafiyogi::values